@@ -0,0 +1,129 @@
+// Frame cost of the player's render path for station lists of different sizes.
+//
+// Each frame is what RadioPlayer does when the FrameScheduler says one is due:
+// take a snapshot, draw it, and report the viewport back to the actor. The
+// cursor moves one station per frame, back and forth within the first few, so
+// the station list repaints every time for every list size. Drawing goes to
+// /dev/null and the synthetic stations point at a closed local port, so the
+// benchmark needs neither a terminal nor a network.
+//
+// Usage: make bench
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "Core/Message.h"
+#include "PersistenceManager.h"
+#include "StationManager.h"
+#include "UI/FrameScheduler.h"
+#include "UI/StateSnapshot.h"
+#include "UIManager.h"
+
+namespace {
+    constexpr int FRAMES_PER_RUN = 240;
+    constexpr int MAX_FPS = 120;    // FrameScheduler's own cap
+    constexpr int SWEEP_LENGTH = 8; // Fits in the smallest list
+    const std::vector<int> STATION_COUNTS = {10, 1000, 50000};
+
+    struct RunResult {
+        int station_count;
+        double mean_us;
+        double p99_us;
+        double worst_us;
+    };
+
+    StationData synthetic_stations(int count) {
+        StationData stations;
+        stations.reserve(count);
+        for (int i = 0; i < count; ++i) {
+            stations.push_back({"Bench Station " + std::to_string(i + 1),
+                                {"http://127.0.0.1:9/bench/" + std::to_string(i + 1)},
+                                {"bench"}});
+        }
+        return stations;
+    }
+
+    RunResult run(int station_count) {
+        StationManager manager(synthetic_stations(station_count));
+        UIManager ui;
+        FrameScheduler scheduler(MAX_FPS);
+        std::vector<double> frame_us;
+        frame_us.reserve(FRAMES_PER_RUN);
+
+        while (static_cast<int>(frame_us.size()) < FRAMES_PER_RUN) {
+            scheduler.requestFrame();
+            auto now = std::chrono::steady_clock::now();
+            if (!scheduler.isFrameDue(now)) {
+                usleep(scheduler.msUntilDue(now) * 1000);
+                continue;
+            }
+            auto start = std::chrono::steady_clock::now();
+            auto snapshot = manager.createSnapshot();
+            ui.draw(snapshot);
+            manager.setViewportRows(ui.getStationViewportRows());
+            auto end = std::chrono::steady_clock::now();
+            scheduler.frameRendered(end);
+            frame_us.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+
+            // Moved now, so the actor has handled it by the next frame.
+            if ((frame_us.size() / SWEEP_LENGTH) % 2 == 0) {
+                manager.post(Msg::NavigateDown{});
+            } else {
+                manager.post(Msg::NavigateUp{});
+            }
+        }
+        manager.post(Msg::Quit{});
+
+        std::sort(frame_us.begin(), frame_us.end());
+        double total = 0.0;
+        for (double us : frame_us)
+            total += us;
+        return {station_count, total / frame_us.size(), frame_us[frame_us.size() * 99 / 100], frame_us.back()};
+    }
+} // namespace
+
+int main() {
+    // Session files land in a scratch directory, not next to the user's own.
+    char scratch_template[] = "/tmp/stream-hopper-bench.XXXXXX";
+    const char* scratch = mkdtemp(scratch_template);
+    if (scratch == nullptr || chdir(scratch) != 0) {
+        perror("render-bench: scratch directory");
+        return 1;
+    }
+    setenv("STREAM_HOPPER_HEALTH_PROBE", "0", 1);
+    setenv("TERM", "xterm-256color", 0);
+    setenv("LINES", "50", 0);
+    setenv("COLUMNS", "160", 0);
+
+    // ncurses draws to stdout and startup warnings go to stderr; keep the real
+    // stdout for the results.
+    int results_fd = dup(STDOUT_FILENO);
+    int null_fd = open("/dev/null", O_WRONLY);
+    dup2(null_fd, STDOUT_FILENO);
+    dup2(null_fd, STDERR_FILENO);
+    close(null_fd);
+
+    std::vector<RunResult> results;
+    for (int station_count : STATION_COUNTS) {
+        results.push_back(run(station_count));
+    }
+
+    fflush(stdout);
+    dup2(results_fd, STDOUT_FILENO);
+    close(results_fd);
+    std::filesystem::remove_all(scratch);
+
+    printf("%10s %14s %14s %14s\n", "stations", "mean (us)", "p99 (us)", "worst (us)");
+    for (const auto& result : results) {
+        printf("%10d %14.1f %14.1f %14.1f\n", result.station_count, result.mean_us, result.p99_us, result.worst_us);
+    }
+    return 0;
+}
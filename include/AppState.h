@@ -28,6 +28,11 @@ enum class ActivePanel {
     HISTORY
 };
 
+enum class SearchScope {
+    STATIONS, // '/': find a station by name or tag
+    HISTORY   // 'h': search every song logged on any station
+};
+
 enum class AppMode {
     CURATED, // Playing from a user-provided file
     RANDOM   // Playing from the dynamic random queue
@@ -0,0 +1,60 @@
+#ifndef CANDIDATEFEED_H
+#define CANDIDATEFEED_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include "CuratorStation.h"
+
+// Pages curation candidates in on a background thread, so a session can
+// start on the first candidate while the rest of a large limit downloads.
+// Duplicates across pages are dropped by station uuid.
+class CandidateFeed {
+  public:
+    using Emit = std::function<void(CuratorStation)>;
+    // Fetches up to `limit` stations starting at `offset`, passing each one to
+    // `emit` as soon as it is parsed. Returns how many entries the page held.
+    // An exception ends the feed with the candidates delivered so far.
+    using PageFetcher = std::function<size_t(int offset, int limit, const Emit& emit)>;
+
+    CandidateFeed(PageFetcher fetch_page, int total_limit);
+    ~CandidateFeed(); // Finishes the page in flight, then stops
+    CandidateFeed(const CandidateFeed&) = delete;
+    CandidateFeed& operator=(const CandidateFeed&) = delete;
+
+    // Blocks until the first candidate arrives; false if none ever will.
+    bool waitForFirst();
+    // Appends the candidates parsed since the last call.
+    void takeArrived(std::vector<CuratorStation>& out);
+    // True once every candidate has arrived, including any not yet taken.
+    bool isFinished() const;
+    // Called on the feed's thread whenever it has news. Must not block.
+    void setListener(std::function<void()> listener);
+
+  private:
+    void run();
+    void deliver(CuratorStation station);
+
+    PageFetcher m_fetch_page;
+    int m_total_limit;
+    std::chrono::steady_clock::time_point m_start_time;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_cond;
+    std::vector<CuratorStation> m_arrived;
+    std::unordered_set<std::string> m_seen_uuids;
+    int m_accepted = 0;
+    bool m_finished = false;
+    std::function<void()> m_listener;
+    std::atomic<bool> m_stop{false};
+    std::thread m_thread;
+};
+
+#endif // CANDIDATEFEED_H
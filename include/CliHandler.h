@@ -1,25 +1,54 @@
 #ifndef CLIHANDLER_H
 #define CLIHANDLER_H
 
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
 #include "CuratorStation.h"
 
+class RadioBrowserClient;
+class StationCatalog;
+
 class CliHandler {
   public:
-    CliHandler() = default;
+    static constexpr int DEFAULT_CURATION_LIMIT = 100;
+
+    CliHandler();
+    ~CliHandler();
 
     // --- Existing CLI-facing methods ---
     void handle_list_tags();
-    void handle_curate_genre(const std::string& genre);
+    void handle_curate_genre(const std::string& genre, int limit = DEFAULT_CURATION_LIMIT);
+    void handle_search_history(const std::string& query);
+    // Builds the local station catalog from a Radio Browser dump (the JSON of /json/stations).
+    void handle_import_catalog(const std::string& dump_filename);
+    // Applies the API's station changes since the catalog was built, or downloads it all if there is none.
+    void handle_refresh_catalog();
 
     // --- New programmatic methods for the Wizard ---
     std::vector<std::string> get_curated_tags();
     std::vector<CuratorStation> get_curation_candidates(const std::string& genre);
+    // Fetches one page of a genre's stations, best voted first, handing each
+    // valid one to `on_candidate` as it is parsed. Returns the page's entry count.
+    size_t stream_curation_candidates(const std::string& genre,
+                                      int offset,
+                                      int limit,
+                                      const std::function<void(CuratorStation)>& on_candidate);
 
     // --- New programmatic method for Random Mode ---
     std::vector<CuratorStation> get_random_stations(int limit);
+
+  private:
+    // The local catalog if one has been imported, opened on first use; random
+    // stations and genres it knows are then answered without the API.
+    const StationCatalog* catalog();
+
+    std::unique_ptr<RadioBrowserClient> m_api; // Shared by every request, including concurrent ones
+    std::once_flag m_catalog_opened;
+    std::unique_ptr<StationCatalog> m_catalog;
 };
 
 #endif // CLIHANDLER_H
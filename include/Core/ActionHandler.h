@@ -12,9 +12,10 @@ class ActionHandler {
     void process_action(StationManager& manager, const StationManagerMessage& msg);
 
   private:
-    void handle_navigateStations(StationManager& manager, NavDirection direction);
-    void handle_navigateHistory(StationManager& manager, NavDirection direction);
-    void handle_navigate(StationManager& manager, NavDirection direction);
+    // `steps` is the net movement of a coalesced run of arrow keys; negative moves up.
+    void handle_navigateStations(StationManager& manager, int steps);
+    void handle_navigateHistory(StationManager& manager, int steps);
+    void handle_navigate(StationManager& manager, int steps);
     void handle_toggleMute(StationManager& manager);
     void handle_toggleAutoHop(StationManager& manager);
     void handle_toggleFavorite(StationManager& manager);
@@ -27,6 +28,19 @@ class ActionHandler {
     void handle_adjustVolumeOffset(StationManager& manager, double amount);
     void handle_enterRandomMode(StationManager& manager);
     void handle_fetchMoreRandomStations(StationManager& manager);
+    void handle_jumpToStation(StationManager& manager, int new_idx);
+
+    // Search ('/' stations, 'h' history)
+    void handle_openSearch(StationManager& manager, SearchScope scope);
+    void handle_searchType(StationManager& manager, char ch);
+    void handle_searchBackspace(StationManager& manager);
+    void handle_searchMove(StationManager& manager, int delta);
+    void handle_searchConfirm(StationManager& manager);
+    void handle_searchCancel(StationManager& manager);
+    void refresh_search(StationManager& manager);
+    void update_search_warm_set(StationManager& manager);
+    void close_search(StationManager& manager);
+    int selected_search_station(const StationManager& manager) const;
 };
 
 #endif // ACTIONHANDLER_H
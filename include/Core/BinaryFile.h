@@ -0,0 +1,92 @@
+#ifndef BINARYFILE_H
+#define BINARYFILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+// Building blocks for the binary caches: the history index, the station
+// catalog and the seen-station filter. Their layouts are native-endian with no
+// padding, since the files never leave this machine. Strings live in a pool at
+// the end of a file and are referred to as {u32 offset, u32 length}.
+constexpr size_t STRING_REF_SIZE = 2 * sizeof(std::uint32_t);
+
+// Assembles a file in memory, value by value.
+class BinaryWriter {
+  public:
+    template <typename T> void put(const T& value) { putBytes(&value, sizeof(T)); }
+    void putBytes(const void* data, size_t size) { m_buffer.append(static_cast<const char*>(data), size); }
+    // Appends the string to the pool and writes its reference.
+    void putStringRef(std::string_view str, std::string& pool);
+    // Overwrites a value put earlier at `pos`, e.g. a size only known at the end.
+    template <typename T> void patch(size_t pos, const T& value) { std::memcpy(&m_buffer[pos], &value, sizeof(T)); }
+    size_t size() const { return m_buffer.size(); }
+    void reserve(size_t size) { m_buffer.reserve(size); }
+    std::string take() { return std::move(m_buffer); }
+
+  private:
+    std::string m_buffer;
+};
+
+// Reads values in sequence from a buffer the caller has already sized up.
+// Nothing past the header is aligned, so every read is a memcpy.
+class BinaryReader {
+  public:
+    BinaryReader(const void* data, size_t pos) : m_data(static_cast<const unsigned char*>(data)), m_pos(pos) {}
+
+    template <typename T> T get() {
+        T value{};
+        std::memcpy(&value, m_data + m_pos, sizeof(T));
+        m_pos += sizeof(T);
+        return value;
+    }
+    template <typename T> void get(T& value) { value = get<T>(); }
+    void getBytes(void* out, size_t size) {
+        std::memcpy(out, m_data + m_pos, size);
+        m_pos += size;
+    }
+    void skip(size_t size) { m_pos += size; }
+
+  private:
+    const unsigned char* m_data;
+    size_t m_pos;
+};
+
+// A whole file mapped read-only. Opening costs a stat and an mmap; pages are
+// only read from disk as they are touched.
+class MappedFile {
+  public:
+    MappedFile() = default;
+    ~MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // Fails if the file is missing or shorter than `min_size`.
+    bool open(const std::string& filename, size_t min_size);
+    void close();
+    bool isOpen() const { return m_data != nullptr; }
+    const unsigned char* data() const { return m_data; }
+    size_t size() const { return m_size; }
+
+    // Unchecked: the caller validates the section offsets once, when opening.
+    template <typename T> T read(size_t offset) const { return BinaryReader(m_data, offset).get<T>(); }
+
+    // Where string references point; set once the header has been validated.
+    void setStringPool(size_t offset, size_t size) {
+        m_pool = offset;
+        m_pool_size = size;
+    }
+    // Resolves the reference at `ref_offset`. The reference itself comes from
+    // the file, so it is bounds-checked here; a corrupt one reads as empty.
+    std::string_view stringAt(size_t ref_offset) const;
+
+  private:
+    const unsigned char* m_data = nullptr;
+    size_t m_size = 0;
+    size_t m_pool = 0;
+    size_t m_pool_size = 0;
+};
+
+#endif // BINARYFILE_H
@@ -0,0 +1,68 @@
+#ifndef HISTORYINDEXFILE_H
+#define HISTORYINDEXFILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Core/BinaryFile.h"
+#include "Core/HistorySearchIndex.h"
+
+class SongHistory;
+
+// Identifies the radio_history.json an index was built from.
+struct HistoryIndexSource {
+    std::uint64_t size;
+    std::int64_t mtime_sec;
+    std::int64_t mtime_nsec;
+};
+
+// The on-disk form of the song history search index, written next to the
+// history by the persistence worker and memory-mapped by `--search-history`.
+// Opening it costs a stat and an mmap; a search only touches the pages of the
+// words, titles and plays it actually matches.
+class HistoryIndexFile {
+  public:
+    HistoryIndexFile() = default;
+    HistoryIndexFile(const HistoryIndexFile&) = delete;
+    HistoryIndexFile& operator=(const HistoryIndexFile&) = delete;
+
+    static std::string serialize(const SongHistory& history, const HistoryIndexSource& source);
+
+    // Fails if the file is missing, malformed or was built from another history.
+    bool open(const std::string& filename, const HistoryIndexSource& expected);
+    bool isOpen() const { return m_file.isOpen(); }
+
+    // Same matching and ordering as HistorySearchIndex::search().
+    std::vector<HistorySearchHit> search(const std::string& query, size_t max_results) const;
+    std::string_view stationName(std::uint32_t station_id) const;
+    std::string_view title(std::uint32_t title_id) const;
+    size_t occurrenceCount() const;
+
+  private:
+    // Byte offsets of each section within the mapping; see the .cpp for the layout.
+    struct Sections {
+        std::uint32_t station_count = 0;
+        std::uint32_t title_count = 0;
+        std::uint32_t occurrence_count = 0;
+        std::uint32_t word_count = 0;
+        std::uint32_t posting_count = 0;
+        size_t stations = 0;
+        size_t titles = 0;
+        size_t title_occurrences = 0;
+        size_t occurrences = 0;
+        size_t words = 0;
+        size_t postings = 0;
+        size_t strings = 0;
+        size_t strings_size = 0;
+    };
+
+    void collectWordTitles(const std::string& word, std::vector<std::uint32_t>& out) const;
+
+    MappedFile m_file;
+    Sections m_sections;
+};
+
+#endif // HISTORYINDEXFILE_H
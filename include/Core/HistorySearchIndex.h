@@ -0,0 +1,53 @@
+#ifndef HISTORYSEARCHINDEX_H
+#define HISTORYSEARCHINDEX_H
+
+#include <cstdint>
+#include <ctime>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class SongHistory;
+
+// One logged play of a title that matched a history search.
+struct HistorySearchHit {
+    std::time_t timestamp;
+    std::uint32_t station_id; // See HistorySearchIndex::stationName()
+    std::uint32_t title_id;   // See SongHistory::title()
+};
+
+// An inverted index (word -> titles) over the song history of every station.
+// Titles are referenced by their SongHistory id, so the index is kept up to
+// date with add() and must be rebuilt whenever its SongHistory is replaced.
+class HistorySearchIndex {
+  public:
+    void clear();
+    void rebuild(const SongHistory& history);
+    void add(const std::string& station_name, std::time_t timestamp, std::uint32_t title_id, const std::string& title);
+
+    // Returns up to `max_results` plays, newest first. Every query word must be
+    // the start of a word in the title, so results narrow as the user types.
+    std::vector<HistorySearchHit> search(const std::string& query, size_t max_results) const;
+    const std::string& stationName(std::uint32_t station_id) const;
+
+    // Shared with HistoryIndexFile and with `--search-history`, which falls back
+    // to matching titles straight off the file when the index is stale.
+    static std::vector<std::string> tokenize(const std::string& text);
+    static bool titleMatches(const std::vector<std::string>& query_words, const std::string& title);
+
+  private:
+    struct Occurrence {
+        std::time_t timestamp;
+        std::uint32_t station_id;
+    };
+
+    void indexTitle(std::uint32_t title_id, const std::string& title);
+
+    std::vector<std::string> m_station_names;
+    std::unordered_map<std::string, std::uint32_t> m_station_ids;
+    std::vector<std::vector<Occurrence>> m_occurrences;          // Indexed by title id
+    std::map<std::string, std::vector<std::uint32_t>> m_postings; // Ordered for prefix lookups
+};
+
+#endif // HISTORYSEARCHINDEX_H
@@ -4,6 +4,8 @@
 #include <string> // For using string in the message
 #include <variant>
 
+#include "AppState.h" // For SearchScope
+
 // This header is now the single source of truth for all message types.
 // Any file that needs to know about messages can include this safely.
 
@@ -11,6 +13,10 @@ namespace Msg {
     // We no longer need a hardcoded enum. The key from the JSON is enough.
     struct NavigateUp {};
     struct NavigateDown {};
+    // The net of a run of NavigateUp/NavigateDown; the actor folds each run into one.
+    struct NavigateBy {
+        int steps; // Negative moves up
+    };
     struct ToggleMute {};
     struct ToggleAutoHop {};
     struct ToggleFavorite {};
@@ -32,10 +38,25 @@ namespace Msg {
     struct AdjustVolumeOffsetUp {};
     struct AdjustVolumeOffsetDown {};
     struct SaveVolumeOffsets {};
+
+    // Search Messages (station finder and history search share the input line)
+    struct OpenSearch {
+        SearchScope scope;
+    };
+    struct SearchType {
+        char ch;
+    };
+    struct SearchBackspace {};
+    struct SearchMove {
+        int delta;
+    };
+    struct SearchConfirm {};
+    struct SearchCancel {};
 }
 
 using StationManagerMessage = std::variant<Msg::NavigateUp,
                                            Msg::NavigateDown,
+                                           Msg::NavigateBy,
                                            Msg::ToggleMute,
                                            Msg::ToggleAutoHop,
                                            Msg::ToggleFavorite,
@@ -51,6 +72,12 @@ using StationManagerMessage = std::variant<Msg::NavigateUp,
                                            Msg::SearchOnline,
                                            Msg::AdjustVolumeOffsetUp,
                                            Msg::AdjustVolumeOffsetDown,
-                                           Msg::SaveVolumeOffsets>;
+                                           Msg::SaveVolumeOffsets,
+                                           Msg::OpenSearch,
+                                           Msg::SearchType,
+                                           Msg::SearchBackspace,
+                                           Msg::SearchMove,
+                                           Msg::SearchConfirm,
+                                           Msg::SearchCancel>;
 
 #endif // MESSAGE_H
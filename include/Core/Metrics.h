@@ -0,0 +1,41 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+
+// A tiny, thread-safe registry of counters and timings. Components record into
+// it freely; the report is only written out when STREAM_HOPPER_METRICS is set.
+class Metrics {
+  public:
+    struct Timing {
+        long count = 0;
+        double total_ms = 0.0;
+        double max_ms = 0.0;
+        double last_ms = 0.0;
+    };
+
+    static void increment(const std::string& name, long amount = 1);
+    static void recordDuration(const std::string& name, double ms);
+    static void recordDuration(const std::string& name, std::chrono::steady_clock::duration duration);
+
+    static long counter(const std::string& name);
+    static Timing timing(const std::string& name);
+
+    // Time since the process started; used for startup milestones.
+    static double msSinceProcessStart();
+
+    static std::string report();
+    // Appends the report to stream_hopper_metrics.log if STREAM_HOPPER_METRICS is set.
+    static void writeReportIfEnabled();
+
+  private:
+    static std::mutex s_mutex;
+    static std::map<std::string, long> s_counters;
+    static std::map<std::string, Timing> s_timings;
+    static const std::chrono::steady_clock::time_point s_process_start;
+};
+
+#endif // METRICS_H
@@ -16,14 +16,18 @@ class MpvEventHandler {
     // The handler now only needs a reference to its owner, the StationManager
     explicit MpvEventHandler(StationManager& manager);
 
-    void handleEvent(mpv_event* event);
+    // `station` is the station whose handle the event was taken from; `from_pending`
+    // is set when that was its pending (URL cycling) instance.
+    void handleEvent(RadioStream& station, mpv_event* event, bool from_pending);
+    // An event from one of the station's racing URLs (see RadioStream::startRace).
+    void handleRacerEvent(RadioStream& station, size_t racer, mpv_event* event);
 
   private:
-    void handlePropertyChange(mpv_event* event);
+    void handlePropertyChange(RadioStream& station, mpv_event* event);
 
     // New helper methods for handlePropertyChange
-    void handle_pending_instance_property_change(mpv_event* event, mpv_event_property* prop);
-    void handle_main_instance_property_change(mpv_event* event, mpv_event_property* prop);
+    void handle_pending_instance_property_change(RadioStream& station, mpv_event_property* prop);
+    void handle_main_instance_property_change(RadioStream& station, mpv_event_property* prop);
 
     // Existing helper methods for specific properties on main instances
     void onTitleProperty(mpv_event_property* prop, RadioStream& station);
@@ -34,8 +38,6 @@ class MpvEventHandler {
     void onTitleChanged(RadioStream& station, const std::string& new_title);
     void onStreamEof(RadioStream& station);
 
-    RadioStream* findStationById(int station_id);
-
     // A reference to the single source of truth.
     StationManager& m_manager;
 };
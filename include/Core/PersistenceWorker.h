@@ -0,0 +1,47 @@
+#ifndef PERSISTENCEWORKER_H
+#define PERSISTENCEWORKER_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+// A write-behind queue for persistence. Callers capture immutable copies of
+// the state they want saved and hand over a job that performs the write on a
+// background thread, so a slow disk never stalls the actor.
+//
+// Jobs are keyed by the file they write. If a job for the same key is still
+// queued when a new one arrives, the old one is dropped: only the newest
+// state is ever written.
+class PersistenceWorker {
+  public:
+    using WriteJob = std::function<void()>;
+
+    PersistenceWorker();
+    ~PersistenceWorker(); // Drains all queued jobs before returning
+
+    PersistenceWorker(const PersistenceWorker&) = delete;
+    PersistenceWorker& operator=(const PersistenceWorker&) = delete;
+
+    void submit(const std::string& key, WriteJob job);
+
+    // Blocks until every job submitted so far has been written.
+    void flush();
+
+  private:
+    void run();
+
+    std::mutex m_mutex;
+    std::condition_variable m_cond;
+    std::condition_variable m_idle_cond;
+    std::deque<std::string> m_order;
+    std::unordered_map<std::string, WriteJob> m_pending;
+    bool m_is_writing = false;
+    bool m_stop = false;
+    std::thread m_thread;
+};
+
+#endif // PERSISTENCEWORKER_H
@@ -18,10 +18,15 @@ namespace Strategy {
 
         // Calculates which station indices should be active (pre-loaded)
         // based on the current mode and user navigation patterns.
+        // `warm_indices` are always included, e.g. the finder's top matches.
+        // Without `wrap_around` (random mode, where the cursor stops at either
+        // end) nothing past the ends of the list is preloaded.
         std::unordered_set<int> calculate_active_indices(int active_idx,
                                                          int station_count,
+                                                         bool wrap_around,
                                                          HopperMode hopper_mode,
-                                                         const std::deque<NavEvent>& nav_history) const;
+                                                         const std::deque<NavEvent>& nav_history,
+                                                         const std::vector<int>& warm_indices) const;
 
       private:
         // Determines the number of stations to preload up and down,
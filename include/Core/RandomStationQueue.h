@@ -0,0 +1,58 @@
+#ifndef RANDOMSTATIONQUEUE_H
+#define RANDOMSTATIONQUEUE_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Core/SeenStationFilter.h"
+#include "CuratorStation.h"
+
+// Random stations fetched ahead of time, so hopping on through random mode
+// never waits on the API.
+//
+// Started the first time random mode is entered, a background thread keeps the
+// queue topped up from then on: whenever it drops below the
+// low-water mark, another batch is fetched (from the local catalog when there
+// is one), stripped of stations already offered and of stations whose host
+// does not resolve, and appended. The lookups also warm a caching resolver
+// for when mpv connects.
+//
+// Offered stations are remembered across sessions in a SeenStationFilter,
+// saved as radio_seen_stations.bin, so they do not come back for months.
+class RandomStationQueue {
+  public:
+    RandomStationQueue();
+    ~RandomStationQueue(); // Waits for an in-flight fetch to return
+
+    RandomStationQueue(const RandomStationQueue&) = delete;
+    RandomStationQueue& operator=(const RandomStationQueue&) = delete;
+
+    // Starts filling the queue. Later calls do nothing.
+    void start();
+
+    // Up to `count` queued stations, never blocking. They are remembered as seen.
+    std::vector<CuratorStation> take(size_t count);
+    // A copy of the seen-station filter, for saving.
+    SeenStationFilter seenStations() const;
+    // True after a fetch came back empty, until one succeeds.
+    bool lastFetchFailed() const;
+
+  private:
+    void run();
+    std::vector<CuratorStation> keepPlayable(std::vector<CuratorStation> fetched);
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_cond;
+    std::deque<CuratorStation> m_queue;
+    SeenStationFilter m_seen; // Loaded by the background thread before its first fetch
+    bool m_last_fetch_failed = false;
+    bool m_stop = false;
+    std::thread m_thread;
+};
+
+#endif // RANDOMSTATIONQUEUE_H
@@ -0,0 +1,51 @@
+#ifndef RECONNECTSCHEDULER_H
+#define RECONNECTSCHEDULER_H
+
+#include <chrono>
+#include <map>
+#include <random>
+#include <vector>
+
+enum class ReconnectState {
+    HEALTHY,    // No failure since it last played
+    WAITING,    // Backing off before the next attempt
+    CONNECTING, // An attempt is in flight
+    PARKED      // Failed too often in a row; left alone for a while
+};
+
+struct ReconnectStatus {
+    ReconnectState state = ReconnectState::HEALTHY;
+    int consecutive_failures = 0;
+    int total_failures = 0; // Since the station was loaded
+    std::chrono::steady_clock::time_point next_attempt;
+};
+
+// Decides when loaded stations whose stream ended may reconnect. Each failure
+// doubles the station's wait (with jitter, so stations that dropped together
+// do not retry together), at most a few reconnects are in flight at once, and
+// a station that keeps failing is parked until its circuit half-opens again.
+// Owned and driven by the actor thread; ids are station list indices.
+class ReconnectScheduler {
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    ReconnectScheduler();
+
+    void onFailure(int station_id, Clock::time_point now);
+    void onConnected(int station_id); // Audio is flowing again
+    // Stations to reconnect now; each is counted as in flight until it connects or fails.
+    std::vector<int> takeDue(Clock::time_point now);
+
+    ReconnectStatus status(int station_id) const;
+    void forget(int station_id); // The station was unloaded
+    void clear();
+    void dropFront(int count); // Station ids moved up by `count`
+
+  private:
+    std::chrono::milliseconds backoff(int consecutive_failures);
+
+    std::map<int, ReconnectStatus> m_stations;
+    std::mt19937 m_rng;
+};
+
+#endif // RECONNECTSCHEDULER_H
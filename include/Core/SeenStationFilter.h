@@ -0,0 +1,55 @@
+#ifndef SEENSTATIONFILTER_H
+#define SEENSTATIONFILTER_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <deque>
+#include <string>
+#include <vector>
+
+// Remembers the station uuids random mode has already offered, across
+// sessions and in fixed memory, so discovery keeps turning up new stations.
+//
+// It is a generational Bloom filter: each of a few generations is a Bloom
+// filter covering an equal slice of the expiry period. New uuids go into the
+// newest one; when it has covered its slice, or holds as many uuids as it was
+// sized for, the oldest generation is dropped. A uuid is therefore forgotten
+// between three quarters of the expiry and the full expiry after it was added.
+//
+// As with any Bloom filter, contains() can answer yes for a uuid that was
+// never added (at about the configured false-positive rate), never no for
+// one that was.
+class SeenStationFilter {
+  public:
+    // `capacity` is how many uuids one generation holds at the configured rate.
+    SeenStationFilter(size_t capacity, double false_positive_rate, std::chrono::seconds expiry);
+
+    bool contains(const std::string& uuid) const;
+    void insert(const std::string& uuid, std::time_t now);
+    // Drops the generations that have outlived the expiry.
+    void expire(std::time_t now);
+
+    std::string serialize() const;
+    // Replaces the contents with a serialized filter. Fails, leaving the filter
+    // empty, if the data is malformed or was sized for other settings.
+    bool deserialize(const std::string& data);
+
+  private:
+    struct Generation {
+        std::int64_t started = 0;
+        std::uint32_t count = 0;
+        std::vector<std::uint64_t> bits;
+    };
+
+    void startGeneration(std::time_t now);
+
+    std::uint32_t m_capacity;
+    std::uint64_t m_bit_count;
+    std::uint32_t m_hash_count;
+    std::int64_t m_generation_span; // Seconds
+    std::deque<Generation> m_generations; // Oldest first
+};
+
+#endif // SEENSTATIONFILTER_H
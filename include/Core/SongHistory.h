@@ -0,0 +1,111 @@
+#ifndef SONGHISTORY_H
+#define SONGHISTORY_H
+
+#include <array>
+#include <cstdint>
+#include <ctime>
+#include <deque>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// A single logged song. Titles are interned in the owning SongHistory so that
+// repeated songs (and the same song heard on several stations) share storage.
+struct HistoryEntry {
+    std::time_t timestamp; // Epoch seconds
+    std::uint32_t title_id;
+};
+
+// An on-disk entry whose timestamp could not be parsed. It is kept verbatim so
+// that saving the history never drops it.
+struct UnparsedHistoryEntry {
+    std::string station_name;
+    std::string timestamp;
+    std::string title;
+};
+
+// Fixed-size, pre-rendered "HH:MM" / "Yesterday" / "Mon DD" label.
+using HistoryTimeLabel = std::array<char, 12>;
+
+// One row of the history panel, ready to be printed as-is. The title points
+// into the SongHistory's interned titles; see SongHistory::titleStorage().
+struct HistoryDisplayRow {
+    HistoryTimeLabel time_label;
+    std::string_view title;
+};
+
+// Renders history timestamps relative to the current local day. The day
+// boundaries are only recomputed when the clock crosses midnight.
+class HistoryTimeFormatter {
+  public:
+    // Returns the start of the current local day, refreshing it if needed.
+    std::time_t todayStart(std::time_t now);
+    void format(std::time_t timestamp, std::time_t today_start, HistoryTimeLabel& out) const;
+
+  private:
+    std::time_t m_today_start = 0;
+    std::time_t m_tomorrow_start = 0;
+};
+
+// The typed, in-memory song history: station name -> chronological entries.
+class SongHistory {
+  public:
+    using Entries = std::vector<HistoryEntry>;
+
+    SongHistory() = default;
+    // The title lookup table is not copied; it is rebuilt if the copy is ever added to.
+    SongHistory(const SongHistory& other);
+    SongHistory& operator=(const SongHistory& other);
+    SongHistory(SongHistory&&) = default;
+    SongHistory& operator=(SongHistory&&) = default;
+
+    // Returns the title's interned id; new titles get the next id in sequence.
+    std::uint32_t add(const std::string& station_name, std::time_t timestamp, const std::string& title);
+    void addUnparsed(UnparsedHistoryEntry entry);
+    const std::vector<UnparsedHistoryEntry>& unparsed() const { return m_unparsed; }
+    const Entries& entriesFor(const std::string& station_name) const;
+    size_t countFor(const std::string& station_name) const;
+    const std::string& title(std::uint32_t title_id) const;
+    size_t titleCount() const;
+
+    // Fills `rows` with up to `max_rows` entries for a station, newest first,
+    // starting `skip` entries from the newest. Labels are cached per station
+    // and only re-rendered when the day changes.
+    void collectRows(const std::string& station_name,
+                     int skip,
+                     int max_rows,
+                     std::time_t now,
+                     std::vector<HistoryDisplayRow>& rows) const;
+
+    const std::unordered_map<std::string, Entries>& stations() const { return m_by_station; }
+    // Keeps the titles that collectRows() rows point into alive, even if this
+    // history is replaced meanwhile. Titles are only ever appended.
+    std::shared_ptr<const void> titleStorage() const { return m_titles; }
+
+    // Parses the on-disk "YYYY-mm-dd HH:MM:SS" format. Returns -1 on failure.
+    static std::time_t parseTimestamp(const std::string& ts_str);
+    static std::string formatTimestamp(std::time_t timestamp);
+
+  private:
+    std::uint32_t intern(const std::string& title);
+
+    struct LabelCache {
+        std::time_t day = 0;
+        std::vector<HistoryTimeLabel> labels;
+    };
+
+    // Deque keeps the views in m_title_ids and in display rows valid as it grows.
+    std::shared_ptr<std::deque<std::string>> m_titles = std::make_shared<std::deque<std::string>>();
+    std::unordered_map<std::string_view, std::uint32_t> m_title_ids;
+    bool m_title_ids_stale = false;
+    std::unordered_map<std::string, Entries> m_by_station;
+    std::vector<UnparsedHistoryEntry> m_unparsed; // Not shown or searched, only written back
+
+    // Display caches are derived data and are refreshed lazily from const readers.
+    mutable std::unordered_map<std::string, LabelCache> m_label_cache;
+    mutable HistoryTimeFormatter m_formatter;
+};
+
+#endif // SONGHISTORY_H
@@ -0,0 +1,86 @@
+#ifndef STATIONCATALOG_H
+#define STATIONCATALOG_H
+
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Core/BinaryFile.h"
+#include "CuratorStation.h"
+
+// Narrows a catalog lookup. Empty fields match every station.
+struct CatalogFilter {
+    std::string tag;          // Lowercase, e.g. "techno"
+    std::string country_code; // e.g. "DE"
+    std::string codec;        // e.g. "MP3"
+    int min_bitrate = 0;      // kbps
+};
+
+// A local copy of the Radio Browser station list, imported from a dump with
+// `--import-catalog` and kept current with `--refresh-catalog`. Like the
+// history index it is memory-mapped: opening costs a stat and an mmap, and a
+// lookup only touches the pages of the stations it returns.
+//
+// Station ids are assigned most voted first, so every posting list in id
+// order is also in votes order.
+class StationCatalog {
+  public:
+    StationCatalog() = default;
+    StationCatalog(const StationCatalog&) = delete;
+    StationCatalog& operator=(const StationCatalog&) = delete;
+
+    // `newest_change` is the latest change time among `stations`; the next
+    // refresh asks the API for what changed after it.
+    static std::string serialize(std::vector<CuratorStation> stations, std::time_t newest_change);
+
+    bool open(const std::string& filename);
+    bool isOpen() const { return m_file.isOpen(); }
+
+    size_t stationCount() const;
+    std::time_t newestChange() const;
+    CuratorStation station(std::uint32_t id) const;
+    bool hasTag(const std::string& tag) const;
+
+    // Ids of the stations matching `filter`, most voted first, after skipping `offset`.
+    std::vector<std::uint32_t> find(const CatalogFilter& filter, size_t offset, size_t limit) const;
+    // Up to `count` distinct stations, each drawn with odds proportional to its votes + 1.
+    std::vector<std::uint32_t> sample(size_t count, std::mt19937& rng) const;
+
+  private:
+    // Byte offsets of each section within the mapping; see the .cpp for the layout.
+    struct Sections {
+        std::uint32_t station_count = 0;
+        std::uint32_t tag_count = 0;
+        std::uint32_t country_count = 0;
+        std::uint32_t codec_count = 0;
+        std::uint32_t posting_count = 0;
+        std::int64_t newest_change = 0;
+        size_t stations = 0;
+        size_t weights = 0;
+        size_t by_bitrate = 0;
+        size_t tags = 0;
+        size_t countries = 0;
+        size_t codecs = 0;
+        size_t postings = 0;
+        size_t strings = 0;
+        size_t strings_size = 0;
+    };
+    // A key's slice of the postings section: [begin, end).
+    struct PostingRange {
+        std::uint32_t begin = 0;
+        std::uint32_t end = 0;
+    };
+
+    bool lookup(size_t keys, std::uint32_t key_count, const std::string& key, PostingRange& range) const;
+    bool rangeContains(const PostingRange& range, std::uint32_t id) const;
+    std::uint32_t bitrate(std::uint32_t id) const;
+
+    MappedFile m_file;
+    Sections m_sections;
+};
+
+#endif // STATIONCATALOG_H
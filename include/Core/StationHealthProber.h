@@ -0,0 +1,64 @@
+#ifndef STATIONHEALTHPROBER_H
+#define STATIONHEALTHPROBER_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "PersistenceManager.h" // For UrlHealth
+
+// Checks every stream URL of the station list in the background, one at a
+// time, a couple of seconds apart and at the lowest CPU priority. Each probe
+// records reachability, time to first byte, codec and bitrate; the results
+// persist in radio_station_health.json, so a URL is only rechecked every few
+// hours (failing ones sooner).
+//
+// The actor polls version() and, when it moves, reorders the URLs of idle
+// stations by score() and flags the ones whose every URL isDead().
+class StationHealthProber {
+  public:
+    StationHealthProber();
+    ~StationHealthProber(); // Saves the results; waits for a probe in flight to time out
+
+    StationHealthProber(const StationHealthProber&) = delete;
+    StationHealthProber& operator=(const StationHealthProber&) = delete;
+
+    // Starts probing, unless STREAM_HOPPER_HEALTH_PROBE=0. Later calls do nothing.
+    void start();
+    // The URLs to keep checking, most urgent first. Replaces the previous list.
+    void setUrls(std::vector<std::string> urls);
+
+    // Changes whenever results change.
+    unsigned long version() const { return m_version; }
+    std::map<std::string, UrlHealth> results() const;
+
+    // Higher is healthier; a URL never probed scores in the middle.
+    static double score(const UrlHealth& health);
+    static bool isDead(const UrlHealth& health);
+
+  private:
+    void run();
+    // The URL due for a probe soonest, and when it is due.
+    bool nextDue(std::string& url, std::chrono::system_clock::time_point& due) const;
+    void record(const std::string& url, bool reachable, int ttfb_ms, const std::string& codec, int bitrate);
+    void saveIfDirty(std::unique_lock<std::mutex>& lock, bool force);
+
+    const bool m_enabled;
+    const std::chrono::seconds m_recheck_interval;
+    mutable std::mutex m_mutex;
+    std::condition_variable m_cond;
+    std::vector<std::string> m_urls;
+    std::map<std::string, UrlHealth> m_health;
+    std::atomic<unsigned long> m_version{0};
+    bool m_dirty = false;
+    std::chrono::steady_clock::time_point m_last_save;
+    bool m_stop = false;
+    std::thread m_thread;
+};
+
+#endif // STATIONHEALTHPROBER_H
@@ -0,0 +1,43 @@
+#ifndef STATIONSEARCHINDEX_H
+#define STATIONSEARCHINDEX_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// A trigram index over station names and tags, used by the '/' station finder.
+//
+// Stations are cheap to add; the trigram postings are built lazily on the
+// first search after new stations arrive, so large lists (and random-mode
+// appends) cost nothing until the finder is actually used.
+class StationSearchIndex {
+  public:
+    void clear();
+    // Station ids are list indices and must be added in increasing order.
+    void add(int station_id, const std::string& name, const std::vector<std::string>& tags);
+    // Forgets the first `count` stations and shifts the remaining ids down to match.
+    void dropFront(size_t count);
+
+    // Returns up to `max_results` station ids, best match first. Matching is
+    // fuzzy: a station qualifies if it shares most of the query's trigrams,
+    // and whole-word, substring and name (over tag) matches rank higher.
+    std::vector<int> search(const std::string& query, size_t max_results);
+
+  private:
+    struct Document {
+        int station_id;
+        std::string name; // Normalized, padded with spaces: " word word "
+        std::string tags; // Normalized, padded the same way
+    };
+
+    static std::string normalize(const std::string& text);
+    void indexPendingDocuments();
+    double score(const Document& doc, const std::string& query, const std::string& padded_query) const;
+
+    std::vector<Document> m_documents;
+    size_t m_indexed_count = 0;
+    std::unordered_map<std::uint32_t, std::vector<std::uint32_t>> m_postings; // Trigram -> document positions
+};
+
+#endif // STATIONSEARCHINDEX_H
@@ -16,6 +16,7 @@ class SystemHandler {
     void handle_saveVolumeOffsets(StationManager& manager);
 
     // Private helpers for each timer-based check
+    void check_navigation_settled(StationManager& manager);
     void check_copy_mode_timeout(StationManager& manager);
     void check_auto_hop_timer(StationManager& manager);
     void check_focus_mode_timer(StationManager& manager);
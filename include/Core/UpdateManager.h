@@ -13,12 +13,16 @@ class UpdateManager {
 
   private:
     // Private helpers for each specific update task
+    void handle_startup_pipeline(StationManager& manager);
     void handle_activeFades(StationManager& manager);
     void handle_cycle_status_timers(StationManager& manager);
     void handle_cycle_timeouts(StationManager& manager);
     void handle_temporary_message_timer(StationManager& manager); // New handler
     void handle_volume_normalizer_timeout(StationManager& manager);
+    void handle_loudness_measurement(StationManager& manager);
     void handle_random_station_fetch(StationManager& manager);
+    void handle_station_health(StationManager& manager);
+    void handle_reconnects(StationManager& manager);
 };
 
 #endif // UPDATEMANAGER_H
@@ -3,6 +3,8 @@
 
 #include <chrono>
 #include <optional>
+#include <string>
+#include <unordered_set>
 
 class RadioStream;
 class StationManager;
@@ -14,7 +16,7 @@ class VolumeNormalizer {
     static constexpr double MAX_OFFSET = 40.0;
     static constexpr double MIN_OFFSET = -40.0;
 
-    VolumeNormalizer() = default;
+    VolumeNormalizer();
 
     // Activates the UI, updates the station's offset, and applies the new combined volume.
     void adjust(StationManager& manager, RadioStream& station, double amount);
@@ -25,11 +27,38 @@ class VolumeNormalizer {
 
     bool isUiActive() const;
 
+    // Automatic mode (STREAM_HOPPER_AUTO_LOUDNESS=1): measures the EBU R128 integrated
+    // loudness of one silent preloaded station at a time and, once the reading settles,
+    // gives it the offset that brings it to TARGET_LOUDNESS. Stations with an offset
+    // already, manual or measured, are left alone. Called every tick; does its work
+    // every MEASURE_POLL_INTERVAL.
+    void measureLoudness(StationManager& manager);
+
   private:
+    struct Measurement {
+        std::string station_name; // Ids shift when random mode trims its list
+        int generation;
+        std::chrono::steady_clock::time_point started;
+        std::optional<double> loudness;
+        std::chrono::steady_clock::time_point loudness_since; // When it last moved noticeably
+    };
+
+    RadioStream* measuredStation(StationManager& manager) const;
+    bool continueMeasurement(StationManager& manager);
+    void startMeasurement(StationManager& manager);
+    void stopMeasurement(RadioStream* station);
+
     bool m_is_ui_active = false;
     std::optional<std::chrono::steady_clock::time_point> m_ui_timeout_end;
 
+    const bool m_auto_enabled;
+    std::optional<Measurement> m_measurement;
+    std::chrono::steady_clock::time_point m_next_measure_poll;
+    std::unordered_set<std::string> m_measured_names; // This session, settled or given up
+
     static constexpr int UI_TIMEOUT_SECONDS = 4;
+    static constexpr double TARGET_LOUDNESS = -14.0; // LUFS
+    static constexpr auto MEASURE_POLL_INTERVAL = std::chrono::seconds(2);
 };
 
 #endif // VOLUMENORMALIZER_H
@@ -0,0 +1,23 @@
+#ifndef WAKEUPSIGNAL_H
+#define WAKEUPSIGNAL_H
+
+// An eventfd that wakes a thread blocked in poll() on fd(). Notifications
+// accumulate until drain() is called, so none is lost while the waiter is busy.
+// notify() only writes to the fd and is safe to call from a signal handler.
+class WakeupSignal {
+  public:
+    WakeupSignal(); // Throws std::runtime_error if the eventfd cannot be created
+    ~WakeupSignal();
+
+    WakeupSignal(const WakeupSignal&) = delete;
+    WakeupSignal& operator=(const WakeupSignal&) = delete;
+
+    void notify();
+    void drain();
+    int fd() const { return m_fd; }
+
+  private:
+    int m_fd;
+};
+
+#endif // WAKEUPSIGNAL_H
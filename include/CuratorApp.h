@@ -2,10 +2,16 @@
 #define CURATORAPP_H
 
 #include <deque>
+#include <future>
+#include <map>
 #include <memory>
 #include <string>
 #include <vector>
 
+#include <mpv/client.h>
+
+#include "CandidateFeed.h"
+#include "Core/WakeupSignal.h"
 #include "CuratorStation.h"
 #include "RadioStream.h"
 
@@ -13,12 +19,23 @@ class CuratorUI;
 
 class CuratorApp {
   public:
-    CuratorApp(const std::string& genre, std::vector<CuratorStation> candidates);
+    // Candidates are reviewed in the order the feed delivers them; the session
+    // can start before the feed has finished. The feed must outlive the app.
+    CuratorApp(const std::string& genre, CandidateFeed& feed);
     ~CuratorApp();
     void run();
 
   private:
+    // Keeps the candidates from `behind` before to `ahead` after the current
+    // one loaded. Streams are started and stopped on background threads, so
+    // keep, discard and back never wait for mpv.
     void update_preloaded_stations();
+    bool is_in_preload_window(int index) const;
+    // Moves finished background loads into the pool; true if the active station arrived.
+    bool adopt_loaded_stations();
+    void retire_station(std::unique_ptr<RadioStream> station);
+    // Only the current station is audible, and only while it isn't paused.
+    void apply_playback_states();
     void advance(bool keep_current);
     void go_back();
     void handle_input(int ch);
@@ -26,7 +43,14 @@ class CuratorApp {
     void save_curated_list() const;
 
     // Helpers for run()
-    void process_mpv_events_for_pool();
+    // Appends candidates the feed has parsed since the last call; true if there were any.
+    bool pull_candidates();
+    // Applies every queued mpv event of the pool; true if the active station changed.
+    bool drain_mpv_events();
+    bool handle_mpv_event(RadioStream& station, const mpv_event* event);
+    // Sleeps until a key arrives, a pooled mpv handle has new events, a
+    // background load finishes or the feed delivers more candidates.
+    void wait_for_events();
     std::string get_active_station_status_string() const;
     CuratorStation get_station_display_data() const;
 
@@ -39,6 +63,8 @@ class CuratorApp {
     void handle_play_toggle_action();
 
     std::string m_genre;
+    CandidateFeed& m_feed;
+    bool m_feed_finished = false;
     std::vector<CuratorStation> m_candidates;
     std::vector<CuratorStation> m_kept_stations;
     std::deque<int> m_history; // Track navigation history
@@ -48,8 +74,12 @@ class CuratorApp {
     bool m_is_active_station_playing = true;
 
     std::unique_ptr<CuratorUI> m_ui;
+    WakeupSignal m_wakeup; // Signalled by mpv, finished loads and the feed; outlives the pool
     std::deque<std::unique_ptr<RadioStream>> m_station_pool;
-    static constexpr int PRELOAD_COUNT = 2;
+    std::map<int, std::future<std::unique_ptr<RadioStream>>> m_loading; // By candidate index
+    std::vector<std::future<void>> m_retiring;                         // Streams shutting down
+    int m_preload_ahead;
+    int m_preload_behind;
 };
 
 #endif // CURATORAPP_H
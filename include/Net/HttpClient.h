@@ -0,0 +1,48 @@
+#ifndef HTTPCLIENT_H
+#define HTTPCLIENT_H
+
+#include <curl/curl.h>
+
+#include <chrono>
+#include <functional>
+#include <istream>
+#include <stdexcept>
+#include <string>
+
+// Thrown for transport failures and non-2xx responses.
+class HttpError : public std::runtime_error {
+  public:
+    HttpError(const std::string& what, bool body_started) : std::runtime_error(what), m_body_started(body_started) {}
+    // True if part of the body had already been handed to the caller.
+    bool bodyStarted() const { return m_body_started; }
+
+  private:
+    bool m_body_started;
+};
+
+// curl_global_init is not thread-safe, so every user of libcurl calls this
+// before creating a handle; only the first call initializes.
+void ensure_curl_initialized();
+
+// A blocking HTTP GET client over libcurl. Connections are kept alive between
+// requests made through the same client, so reuse one per thread. Not thread-safe.
+class HttpClient {
+  public:
+    HttpClient();
+    ~HttpClient();
+    HttpClient(const HttpClient&) = delete;
+    HttpClient& operator=(const HttpClient&) = delete;
+
+    std::string get(const std::string& url, std::chrono::milliseconds timeout);
+    // Hands the body to `consume` as a stream while it is still downloading.
+    // If `consume` returns early, the rest of the response is dropped.
+    void get(const std::string& url,
+             std::chrono::milliseconds timeout,
+             const std::function<void(std::istream&)>& consume);
+
+  private:
+    CURL* m_easy;
+    CURLM* m_multi; // Owns the connection cache
+};
+
+#endif // HTTPCLIENT_H
@@ -0,0 +1,74 @@
+#ifndef RADIOBROWSERCLIENT_H
+#define RADIOBROWSERCLIENT_H
+
+#include <chrono>
+#include <functional>
+#include <future>
+#include <istream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "PersistenceManager.h"
+
+class HttpClient;
+class ResponseCache;
+
+// Talks to the Radio Browser API in-process. The mirrors behind
+// all.api.radio-browser.info are ranked by response time on first use and
+// the ranking is cached on disk for a day. A request that cannot reach its
+// mirror moves on to the next one. Safe to share between threads.
+//
+// Tag lists and per-genre station pages are cached on disk. A stale entry is
+// returned at once and refreshed in the background; one too old to show is
+// refetched, but is still used if no mirror can be reached.
+//
+// STREAM_HOPPER_API_MIRRORS (comma-separated base URLs) replaces the DNS
+// lookup and the on-disk ranking, e.g. to point at a local stand-in server.
+class RadioBrowserClient {
+  public:
+    RadioBrowserClient();
+    ~RadioBrowserClient(); // Waits for background refreshes to be written
+    RadioBrowserClient(const RadioBrowserClient&) = delete;
+    RadioBrowserClient& operator=(const RadioBrowserClient&) = delete;
+
+    // `path` includes the query, e.g. "/json/tags?order=stationcount".
+    // Both throw std::runtime_error once every mirror has failed.
+    std::string get(const std::string& path);
+    // Streams the body into `consume`. A mirror that fails after part of the
+    // body was consumed is not retried, since the caller has already seen it.
+    void get(const std::string& path, const std::function<void(std::istream&)>& consume);
+
+  private:
+    // How long a response to `path` stays fresh; nullopt if it is not cached.
+    std::optional<std::chrono::seconds> cacheTtl(const std::string& path) const;
+    // Requests `path`, passing the body through to `consume` and caching it.
+    void fetchAndStore(const std::string& path, const std::function<void(std::istream&)>& consume);
+    void revalidate(const std::string& path);
+
+    void request(const std::string& path, const std::function<void(HttpClient&, const std::string&)>& attempt);
+    // The mirrors to try, fastest first, starting with the last one that worked.
+    std::vector<ApiMirror> mirrorsToTry(bool rerank);
+    std::vector<ApiMirror> rankMirrors() const;
+    void markWorking(const std::string& base_url);
+
+    std::unique_ptr<HttpClient> acquireClient();
+    void releaseClient(std::unique_ptr<HttpClient> client);
+
+    const bool m_mirrors_overridden;
+    const std::chrono::seconds m_tags_ttl;
+    const std::chrono::seconds m_stations_ttl;
+    std::unique_ptr<ResponseCache> m_cache;
+    std::mutex m_mutex;
+    std::vector<ApiMirror> m_mirrors;
+    std::string m_working_mirror;
+    bool m_ranking_from_disk = false;
+    std::vector<std::unique_ptr<HttpClient>> m_idle_clients; // Each keeps its connections alive
+    std::set<std::string> m_revalidating;                     // Paths being refreshed
+    std::vector<std::future<void>> m_revalidations;
+};
+
+#endif // RADIOBROWSERCLIENT_H
@@ -0,0 +1,35 @@
+#ifndef RESPONSECACHE_H
+#define RESPONSECACHE_H
+
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+#include <optional>
+#include <string>
+
+// API response bodies on disk, one file per request path. An entry's age is
+// taken from its file's mtime, so it survives restarts. When the directory
+// grows past its size limit, the oldest entries are removed first.
+class ResponseCache {
+  public:
+    struct Entry {
+        std::string body;
+        std::chrono::system_clock::duration age;
+    };
+
+    ResponseCache(std::string directory, size_t max_bytes);
+
+    std::optional<Entry> load(const std::string& key) const;
+    // Failures are ignored; a missing entry only costs a request.
+    void store(const std::string& key, const std::string& body);
+
+  private:
+    std::string pathFor(const std::string& key) const;
+    void evictOverLimit();
+
+    std::string m_directory;
+    size_t m_max_bytes;
+    std::mutex m_mutex; // Serializes writers; readers only ever see whole files
+};
+
+#endif // RESPONSECACHE_H
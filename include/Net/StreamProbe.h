@@ -0,0 +1,33 @@
+#ifndef STREAMPROBE_H
+#define STREAMPROBE_H
+
+#include <curl/curl.h>
+
+#include <chrono>
+#include <string>
+
+// What a short look at a stream found.
+struct StreamProbeResult {
+    bool reachable = false;
+    std::chrono::milliseconds time_to_first_byte{0};
+    std::string codec; // e.g. "MP3", "AAC", "OGG"; empty if it could not be told
+    int bitrate = 0;   // kbps, from the icy headers; 0 if not announced
+    std::string error; // Why it was unreachable
+};
+
+// Opens a stream, reads its headers and first few kilobytes, and hangs up.
+// Not thread-safe; one probe runs at a time per instance.
+class StreamProbe {
+  public:
+    StreamProbe();
+    ~StreamProbe();
+    StreamProbe(const StreamProbe&) = delete;
+    StreamProbe& operator=(const StreamProbe&) = delete;
+
+    StreamProbeResult probe(const std::string& url, std::chrono::milliseconds timeout);
+
+  private:
+    CURL* m_easy;
+};
+
+#endif // STREAMPROBE_H
@@ -1,49 +1,102 @@
 #ifndef PERSISTENCEMANAGER_H
 #define PERSISTENCEMANAGER_H
 
+#include <chrono>
+#include <ctime>
+#include <functional>
 #include <map>
 #include <optional>
 #include <string>
 #include <unordered_set>
-#include <utility> // For std::pair
 #include <vector>
 
+#include "Core/SongHistory.h"
 #include "CuratorStation.h"
-#include "nlohmann/json.hpp"
 
-// Forward declaration
-class RadioStream;
+class HistoryIndexFile;
+class SeenStationFilter;
+class StationCatalog;
+
+// One station as read from a station list. Tags are optional; curated lists carry them.
+struct StationEntry {
+    std::string name;
+    std::vector<std::string> urls;
+    std::vector<std::string> tags;
+};
 
 // A type alias for clarity
-using StationData = std::vector<std::pair<std::string, std::vector<std::string>>>;
+using StationData = std::vector<StationEntry>;
+
+// A Radio Browser API server and how quickly it answered when last ranked.
+struct ApiMirror {
+    std::string base_url; // e.g. "https://de1.api.radio-browser.info"
+    double latency_ms = 0.0;
+};
+
+// The background prober's record of one stream URL.
+struct UrlHealth {
+    double reliability = 0.0;      // Moving average of probe successes, 0..1
+    int time_to_first_byte_ms = 0; // Of the last successful probe
+    std::string codec;
+    int bitrate = 0; // kbps, as announced by the server
+    std::time_t last_checked = 0;
+    int consecutive_failures = 0;
+};
 
+// Save methods write atomically (temp file + rename) and throw std::runtime_error
+// on failure. They are called from the PersistenceWorker thread, so they must
+// only touch the arguments they are given.
 class PersistenceManager {
   public:
     PersistenceManager() = default;
 
+    // Streams the list through a SAX parser. The result is cached next to the
+    // list (`<filename>.cache`) and reused while the file's size and mtime match.
     StationData loadStations(const std::string& filename) const;
     void saveSimpleStationList(const std::string& filename, const std::vector<CuratorStation>& stations) const;
 
     // History Persistence
-    nlohmann::json loadHistory() const;
-    void saveHistory(const nlohmann::json& history_data) const;
+    // Called once per entry with the raw on-disk timestamp ("YYYY-mm-dd HH:MM:SS").
+    using HistoryVisitor =
+        std::function<void(const std::string& station_name, const std::string& timestamp, const std::string& title)>;
+    // Streams the history file without building a DOM.
+    void scanHistory(const HistoryVisitor& visitor) const;
+    SongHistory loadHistory() const;
+    void saveHistory(const SongHistory& history) const;
+    // The search index is keyed to the history file's size and mtime, so it
+    // must be written after saveHistory(). open fails if the two have diverged.
+    void saveHistoryIndex(const SongHistory& history) const;
+    bool openHistoryIndex(HistoryIndexFile& index) const;
+
+    // Station Catalog Persistence
+    void saveStationCatalog(std::vector<CuratorStation> stations, std::time_t newest_change) const;
+    bool openStationCatalog(StationCatalog& catalog) const;
+
+    // Random Mode Seen-Station Persistence
+    // Leaves `filter` empty if the file is missing or was written with other settings.
+    bool loadSeenStations(SeenStationFilter& filter) const;
+    void saveSeenStations(const SeenStationFilter& filter) const;
 
     // Favorites Persistence
     std::unordered_set<std::string> loadFavoriteNames() const;
-    void saveFavorites(const std::vector<RadioStream>& stations) const;
+    void saveFavorites(const std::vector<std::string>& favorite_names) const;
 
     // Session Persistence
     std::optional<std::string> loadLastStationName() const;
     void saveSession(const std::string& last_station_name) const;
 
+    // API Mirror Ranking Persistence
+    // Returns an empty list if the ranking is missing, unreadable or older than `max_age`.
+    std::vector<ApiMirror> loadApiMirrors(std::chrono::seconds max_age) const;
+    void saveApiMirrors(const std::vector<ApiMirror>& mirrors) const;
+
+    // Stream Health Persistence, keyed by URL
+    std::map<std::string, UrlHealth> loadStationHealth() const;
+    void saveStationHealth(const std::map<std::string, UrlHealth>& health) const;
+
     // Volume Offset Persistence
     std::map<std::string, double> loadVolumeOffsets() const;
     void saveVolumeOffsets(const std::map<std::string, double>& offsets) const;
-
-  private:
-    // Helper to parse a single station entry from the JSON array
-    std::optional<std::pair<std::string, std::vector<std::string>>>
-    parse_single_station_entry(const nlohmann::json& station_entry) const;
 };
 
 #endif // PERSISTENCEMANAGER_H
@@ -10,6 +10,7 @@
 class UIManager;
 class StationManager;
 #include "Core/Message.h" // Include the new message header
+#include "UI/FrameScheduler.h"
 
 class RadioPlayer {
   public:
@@ -21,11 +22,22 @@ class RadioPlayer {
 
   private:
     void handleInput(int ch);
+    void handleSearchInput(int ch);
 
     std::map<int, StationManagerMessage> m_input_handlers;
     std::unique_ptr<UIManager> m_ui;
     // StationManager is now the owner of all state, we just talk to it.
     StationManager& m_station_manager;
+    RenderSettings m_render_settings;
+    FrameScheduler m_frame_scheduler;
+    // Predicted here so that keys typed right after '/' or 'h' are never mistaken
+    // for commands before the actor catches up. Once a snapshot has seen every
+    // open/close request posted, it is taken as the truth again: the actor also
+    // closes the search itself, e.g. when random mode replaces the list.
+    bool m_is_search_active = false;
+    int m_search_requests_posted = 0;
+    // As of the last frame; cleared as soon as a key leaves copy mode.
+    bool m_is_copy_mode_active = false;
 };
 
 #endif // RADIOPLAYER_H
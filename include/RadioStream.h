@@ -2,6 +2,7 @@
 #define RADIOSTREAM_H
 
 #include <chrono>
+#include <cstdint>
 #include <optional>
 #include <string>
 #include <vector>
@@ -24,6 +25,11 @@ enum class CyclingState {
 
 class RadioStream {
   public:
+    // Reply ids for observed properties. mpv scopes them to a handle, so they
+    // only tell the main instance's changes from the pending one's.
+    static constexpr std::uint64_t MAIN_REPLY_ID = 1;
+    static constexpr std::uint64_t PENDING_REPLY_ID = 2;
+
     RadioStream(int id, std::string name, std::vector<std::string> urls);
 
     ~RadioStream() = default;
@@ -52,12 +58,31 @@ class RadioStream {
     std::optional<std::chrono::steady_clock::time_point> getCycleStartTime() const;
     // ------------------------------------
 
+    // --- URL Racing ---
+    // Opens up to racer_count of the following URLs muted, next to the main instance.
+    // Racers observe with PENDING_REPLY_ID, so a winner moved into the pending slot
+    // finishes through the ordinary cycle crossfade.
+    void startRace(size_t racer_count);
+    void endRace(); // Cancels the racers still connecting
+    bool isRacing() const;
+    size_t getRacerCount() const;
+    mpv_handle* getRacerHandle(size_t racer) const;
+    void setRacerTitle(size_t racer, const std::string& title);
+    void dropRacer(size_t racer);
+    // Makes the racer the pending instance of a new cycle and cancels the rest.
+    void promoteRacer(size_t racer);
+    std::optional<std::chrono::steady_clock::time_point> getRaceStartTime() const;
+    // ------------------------------------
+
     bool isInitialized() const;
     int getGeneration() const;
     int getID() const;
+    void setID(int id); // Ids are list indices; they shift when random mode trims its list
     const std::string& getName() const;
     const std::string& getActiveUrl() const;
     const std::vector<std::string>& getAllUrls() const;
+    // Reorders the URLs, healthiest first. Ignored while the station is loaded or cycling.
+    void setUrlOrder(std::vector<std::string> urls);
     size_t getActiveUrlIndex() const;
     mpv_handle* getMpvHandle() const;
 
@@ -89,7 +114,17 @@ class RadioStream {
     double getVolumeOffset() const;
     void setVolumeOffset(double offset);
 
+    // Set when the health prober has found every URL dead.
+    bool isUnreachable() const;
+    void setUnreachable(bool unreachable);
+
   private:
+    struct Racer {
+        MpvInstance instance;
+        size_t url_index;
+        std::string title;
+    };
+
     int m_id;
     std::string m_name;
     std::vector<std::string> m_urls;
@@ -104,6 +139,10 @@ class RadioStream {
     std::string m_pending_title;
     int m_pending_bitrate;
     std::optional<std::chrono::steady_clock::time_point> m_cycle_start_time;
+    size_t m_pending_url_index;
+
+    std::vector<Racer> m_racers;
+    std::optional<std::chrono::steady_clock::time_point> m_race_start_time;
 
     std::string m_current_title;
     int m_bitrate;
@@ -117,6 +156,7 @@ class RadioStream {
     bool m_is_buffering;
     std::optional<std::chrono::steady_clock::time_point> m_mute_start_time;
     double m_volume_offset;
+    bool m_is_unreachable;
 };
 
 #endif // RADIOSTREAM_H
@@ -5,8 +5,10 @@
 #include <deque>
 #include <optional>
 #include <string>
+#include <vector>
 
 #include "AppState.h"
+#include "Core/HistorySearchIndex.h"
 
 /**
  * @class SessionState
@@ -28,10 +30,26 @@ struct SessionState {
 
     bool auto_hop_mode_active = false;
     std::chrono::steady_clock::time_point auto_hop_start_time;
+    long auto_hop_drawn_elapsed_s = -1; // The countdown only needs a frame when its second changes
 
     // Navigation & Preloading State
     std::deque<NavEvent> nav_history;
     std::chrono::steady_clock::time_point last_switch_time;
+    // Set while the cursor is moving fast: the preload window is only
+    // recomputed once navigation has been quiet until this time.
+    std::optional<std::chrono::steady_clock::time_point> window_commit_deadline;
+
+    // Search State (station finder or history search, see SearchScope)
+    bool search_active = false;
+    SearchScope search_scope = SearchScope::STATIONS;
+    std::string search_query;
+    int search_selected = 0;
+    std::vector<int> station_search_results;              // Station indices, best match first
+    std::vector<HistorySearchHit> history_search_results; // Newest first
+    std::vector<int> warm_station_indices;                // Extra stations the preloader keeps loaded
+    // OpenSearch, SearchConfirm and SearchCancel messages handled so far; the UI
+    // compares it with what it sent to tell whether a snapshot has caught up.
+    int search_requests_handled = 0;
 
     // Session Statistics & Lifecycle
     std::chrono::steady_clock::time_point session_start_time;
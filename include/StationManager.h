@@ -3,11 +3,13 @@
 
 #include <atomic>
 #include <condition_variable>
+#include <ctime>
 #include <deque>
 #include <future>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <string>
 #include <thread>
 #include <unordered_set>
@@ -15,6 +17,8 @@
 #include <vector>
 
 #include "Core/Message.h"
+#include "Core/SongHistory.h"
+#include "Core/WakeupSignal.h"
 #include "Core/PreloadStrategy.h"
 #include "PersistenceManager.h" // For StationData
 #include "RadioStream.h"
@@ -24,6 +28,12 @@
 #include "nlohmann/json.hpp"
 
 class MpvEventHandler;
+class PersistenceWorker;
+class RandomStationQueue;
+class ReconnectScheduler;
+class StationHealthProber;
+class StationSearchIndex;
+class HistorySearchIndex;
 class ActionHandler;
 class SystemHandler;
 class UpdateManager;
@@ -51,15 +61,17 @@ thread-safe. It is the single source of truth for application state.
 
 --- UI Redraw Philosophy (IMPORTANT) ---
 
-The m_needs_redraw flag is the sole mechanism for triggering a UI update.
+requestRedraw() is the sole mechanism for triggering a UI update.
 
-It must be set to true whenever the internal state changes in a way that
+It must be called whenever the internal state changes in a way that
 
-needs to be visually communicated to the user. Failure to set the flag results
+needs to be visually communicated to the user. Failure to call it results
 
-in a stale, unresponsive UI. Setting it unnecessarily causes excessive CPU usage
+in a stale, unresponsive UI. Requests coalesce: the UI draws at most one frame
 
-and screen flicker.
+per burst of requests, capped by its frame rate, so calling it unnecessarily
+
+costs a snapshot and a frame rather than a redraw per call.
 
 A redraw is warranted under the following conditions:
 
@@ -109,8 +121,19 @@ class StationManager {
     ~StationManager();
     void post(StationManagerMessage message);
     StateSnapshot createSnapshot() const;
-    std::atomic<bool>& getNeedsRedrawFlag();
+    // Marks the UI stale and wakes the UI thread. Callable from any thread.
+    void requestRedraw();
+    // Clears and returns the pending redraw request; called by the UI thread.
+    bool takeRedrawRequest();
+    // Becomes readable when a redraw is requested or the actor quits.
+    int getUiWakeupFd() const;
     std::atomic<bool>& getQuitFlag();
+    // With animations off (low-bandwidth rendering), fades and spinners no
+    // longer request a frame per step; only their end state is redrawn.
+    void setAnimationsEnabled(bool enabled);
+    // Tells the actor how many rows the station list shows, so snapshots only
+    // need to carry the stations around the active one.
+    void setViewportRows(int rows);
 
     // Centralized volume logic to be called by handlers/managers
     void applyCombinedVolume(int station_id, bool for_pending = false);
@@ -132,9 +155,19 @@ class StationManager {
     void initializeStation(int station_idx);
     void shutdownStation(int station_idx);
     void saveHistoryToDisk();
-    void addHistoryEntry(const std::string& station_name, const nlohmann::json& entry);
-    void loadSearchProviders(); // New method to load config
+    void saveFavoritesToDisk();
+    void addHistoryEntry(const std::string& station_name, std::time_t timestamp, const std::string& title);
+    static std::map<char, SearchProvider> loadSearchProviders();
+    bool isStartupDataReady() const;
+    void applyStartupData();
+    void onFirstAudio();
     void saveVolumeOffsetsToDisk();
+    // Moves the next stations from the random queue into the list; false if none were queued.
+    bool takeRandomStations(bool append);
+    // Keeps a long random-mode session to a bounded window of stations around the cursor.
+    void trimRandomWindow();
+    // Hands every station URL to the health prober, the ones nearest the cursor first.
+    void watchStationUrls();
 
     struct ActiveFade {
         int station_id;
@@ -148,23 +181,60 @@ class StationManager {
 
     // Core Components & Data
     mutable std::mutex m_stations_mutex;
-    std::vector<RadioStream> m_stations;
+    std::deque<RadioStream> m_stations; // A deque, so appending never moves a live stream
     std::vector<ActiveFade> m_active_fades;
     std::unordered_set<int> m_active_station_indices;
-    std::unordered_set<std::string> m_seen_random_station_uuids;
+    // Saved state of stations trimmed from random mode, merged in whenever favorites
+    // or volume offsets are saved. Their song history stays in m_song_history.
+    std::unordered_set<std::string> m_archived_favorites;
+    std::map<std::string, double> m_archived_volume_offsets;
     Strategy::Preloader m_preloader;
     std::unique_ptr<MpvEventHandler> m_event_handler;
     std::unique_ptr<ActionHandler> m_action_handler;
     std::unique_ptr<SystemHandler> m_system_handler;
     std::unique_ptr<UpdateManager> m_update_manager;
     std::unique_ptr<VolumeNormalizer> m_volume_normalizer;
-    std::unique_ptr<nlohmann::json> m_song_history;
-    int m_unsaved_history_count;
+    std::unique_ptr<PersistenceWorker> m_persistence_worker;
+    std::unique_ptr<ReconnectScheduler> m_reconnect_scheduler;
+    std::unique_ptr<RandomStationQueue> m_random_station_queue; // Started when random mode is first entered
+    std::unique_ptr<StationHealthProber> m_health_prober;        // Started once startup settles
+    unsigned long m_applied_health_version = 0;
+    std::unique_ptr<SongHistory> m_song_history;
+    std::unique_ptr<StationSearchIndex> m_station_search_index;
+    std::unique_ptr<HistorySearchIndex> m_history_search_index; // Mirrors m_song_history
+    // Songs logged since the last history save. Saving hands only these to the
+    // worker, which keeps its own copy of the whole history up to date.
+    struct LoggedSong {
+        std::string station_name;
+        std::time_t timestamp;
+        std::string title;
+    };
+    struct HistoryWriteBehind {
+        std::mutex mutex;
+        std::vector<LoggedSong> pending; // Guarded by mutex
+        std::optional<SongHistory> history; // Worker thread only; read from disk on first save
+    };
+    std::vector<LoggedSong> m_unsaved_songs;
+    std::shared_ptr<HistoryWriteBehind> m_history_write_behind;
     std::map<char, SearchProvider> m_search_providers; // Store config here
 
-    // Async Fetching State
+    // Staged Startup State (see constructor)
+    struct StartupLoad {
+        std::future<SongHistory> history;
+        std::future<std::unordered_set<std::string>> favorite_names;
+        std::future<std::map<std::string, double>> volume_offsets;
+        std::future<std::map<char, SearchProvider>> search_providers;
+    };
+    StartupLoad m_startup_load;
+    bool m_startup_data_applied = false;
+    // Favorites toggled before the saved ones were merged in; the file's stale value must not undo them.
+    std::unordered_set<std::string> m_favorites_toggled_early;
+    bool m_startup_window_filled = false;
+    bool m_first_audio_recorded = false;
+    std::chrono::steady_clock::time_point m_startup_stage_start;
+
+    // Random Mode State: set while the list waits on an empty random queue
     std::atomic<bool> m_is_fetching_random_stations;
-    std::future<std::vector<CuratorStation>> m_random_stations_future;
     bool m_fetch_is_for_append;
 
     // Encapsulated Application State
@@ -173,11 +243,19 @@ class StationManager {
     // Actor Model Internals
     std::atomic<bool> m_quit_flag;
     std::atomic<bool> m_needs_redraw;
+    std::atomic<long> m_redraw_requests{0}; // Redraw demand, reported as ui.redraw_requests
+    std::atomic<bool> m_animations_enabled{true};
+    std::atomic<int> m_viewport_rows;
+    WakeupSignal m_ui_wakeup;
     std::thread m_actor_thread;
     std::deque<StationManagerMessage> m_message_queue;
     std::mutex m_queue_mutex;
     std::condition_variable m_queue_cond;
 
+    // How long the cursor must rest before a burst of navigation reaches the preloader
+    const std::chrono::milliseconds m_nav_settle_delay;
+    const int m_url_race; // URLs opened at once by a station starting under the cursor
+
     // Constants
     static constexpr size_t MAX_NAV_HISTORY = 10;
     static constexpr int HISTORY_WRITE_THRESHOLD = 5;
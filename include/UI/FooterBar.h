@@ -14,7 +14,12 @@ class FooterBar : public Panel {
               bool is_copy_mode_active,
               bool is_auto_hop_mode_active,
               bool can_cycle_url,
+              bool is_search_active,
               const std::string& temp_msg);
+
+  private:
+    std::string m_last_text;
+    bool m_last_highlighted = false;
 };
 
 #endif // FOOTERBAR_H
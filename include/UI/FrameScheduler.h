@@ -0,0 +1,40 @@
+#ifndef FRAMESCHEDULER_H
+#define FRAMESCHEDULER_H
+
+#include <chrono>
+
+// How the UI renders, chosen once at startup from the environment:
+//   STREAM_HOPPER_MAX_FPS=<n>        caps the frame rate (default 30)
+//   STREAM_HOPPER_LOW_BANDWIDTH=1|0  forces the low-bandwidth profile on or off
+// The low-bandwidth profile (a few frames per second, no fade or spinner
+// animation) is picked automatically when running over SSH.
+struct RenderSettings {
+    int max_fps = 30;
+    bool animations_enabled = true;
+
+    static RenderSettings fromEnvironment();
+};
+
+// Turns redraw requests into frames no faster than the configured rate. Any
+// number of requests between two frames coalesce into the next one.
+class FrameScheduler {
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit FrameScheduler(int max_fps);
+
+    void requestFrame() { m_frame_pending = true; }
+    bool isFramePending() const { return m_frame_pending; }
+    // True if a frame is pending and the minimum frame interval has passed.
+    bool isFrameDue(Clock::time_point now) const;
+    void frameRendered(Clock::time_point now);
+    // Milliseconds until the pending frame may be drawn (0 if it is due).
+    int msUntilDue(Clock::time_point now) const;
+
+  private:
+    Clock::duration m_min_interval;
+    Clock::time_point m_last_frame;
+    bool m_frame_pending = true; // The first frame is always wanted
+};
+
+#endif // FRAMESCHEDULER_H
@@ -7,6 +7,14 @@
 class HeaderBar : public Panel {
   public:
     void draw(double current_volume, HopperMode hopper_mode, AppMode app_mode, bool is_fetching);
+    void setAnimated(bool animated) { m_animated = animated; }
+
+  private:
+    bool m_animated = true;
+    int m_last_volume = -1;
+    HopperMode m_last_hopper_mode = HopperMode::BALANCED;
+    AppMode m_last_app_mode = AppMode::CURATED;
+    bool m_last_fetching = false;
 };
 
 #endif // HEADERBAR_H
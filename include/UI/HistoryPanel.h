@@ -1,15 +1,20 @@
 #ifndef HISTORYPANEL_H
 #define HISTORYPANEL_H
 
-#include "UI/Panel.h"
-#include "nlohmann/json.hpp"
+#include <string>
+#include <vector>
 
-struct StationDisplayData;
+#include "Core/SongHistory.h"
+#include "UI/ListPanel.h"
 
-class HistoryPanel : public Panel {
+struct HistorySearchRow;
+
+class HistoryPanel : public ListPanel {
   public:
-    void
-    draw(const StationDisplayData& station, const nlohmann::json& station_history, int scroll_offset, bool is_focused);
+    // Rows arrive pre-rendered and already offset by the scroll position.
+    void draw(const std::vector<HistoryDisplayRow>& rows, bool is_focused);
+    // Replaces the panel with the 'h' search's query and matching plays.
+    void drawSearch(const std::string& query, const std::vector<HistorySearchRow>& rows, int selected);
 };
 
 #endif // HISTORYPANEL_H
@@ -0,0 +1,27 @@
+#ifndef LISTPANEL_H
+#define LISTPANEL_H
+
+#include <string>
+#include <vector>
+
+#include "UI/Panel.h"
+
+// A boxed panel showing rows of text. Subclasses format their rows and hand
+// them to present(), which skips the repaint if nothing on screen would change.
+class ListPanel : public Panel {
+  protected:
+    struct ListLine {
+        std::string text;
+        attr_t attrs;
+        bool operator==(const ListLine& other) const { return text == other.text && attrs == other.attrs; }
+    };
+
+    void present(const std::string& title, bool is_focused, int text_x, std::vector<ListLine> lines);
+
+  private:
+    std::string m_last_title;
+    bool m_last_focused = false;
+    std::vector<ListLine> m_last_lines;
+};
+
+#endif // LISTPANEL_H
@@ -3,17 +3,25 @@
 
 #include "UI/Panel.h"
 #include "UI/StateSnapshot.h"
-#include "nlohmann/json.hpp"
 
 class NowPlayingPanel : public Panel {
   public:
     void draw(const StateSnapshot& snapshot);
+    void setAnimated(bool animated) { m_animated = animated; }
 
   private:
     void drawAutoHopView(int inner_w, int remaining_seconds, int total_duration);
     void drawNormalView(const StationDisplayData& station, int inner_w);
     void drawVolumeOffsetBar(const StationDisplayData& station, int inner_w);
     void drawCycleStatus(const StationDisplayData& station, int inner_w);
+
+    bool m_animated = true;
+    // What the last repaint showed.
+    StationDisplayData m_last_station{};
+    bool m_last_auto_hop = false;
+    int m_last_auto_hop_remaining = 0;
+    int m_last_auto_hop_total = 0;
+    bool m_last_volume_offset_mode = false;
 };
 
 #endif // NOWPLAYINGPANEL_H
@@ -1,20 +1,34 @@
 #ifndef PANEL_H
 #define PANEL_H
 
+#include <ncurses.h>
+
+// Each panel owns an ncurses window covering its slice of the screen. Panels
+// only repaint when what they show has changed; a repaint is queued with
+// wnoutrefresh() and the UIManager flushes every panel with a single doupdate().
 class Panel {
   public:
     Panel() : m_y(0), m_x(0), m_w(0), m_h(0) {}
-    virtual ~Panel() = default;
+    virtual ~Panel();
+    Panel(const Panel&) = delete;
+    Panel& operator=(const Panel&) = delete;
 
-    void setDimensions(int y, int x, int w, int h) {
-        m_y = y;
-        m_x = x;
-        m_w = w;
-        m_h = h;
-    }
+    // Recreates the window if the geometry changed. A zero-sized panel has no window.
+    void setDimensions(int y, int x, int w, int h);
+    // Forces the next draw to repaint even if its inputs are unchanged.
+    void invalidate() { m_dirty = true; }
+    // Blanks the panel on screen; the next draw repaints it.
+    void blank();
 
   protected:
+    // Clears the window for a repaint. Returns false if the panel is hidden.
+    bool beginRepaint();
+    // Queues the repainted window for the next doupdate().
+    void endRepaint();
+
+    WINDOW* m_win = nullptr;
     int m_y, m_x, m_w, m_h;
+    bool m_dirty = true;
 };
 
 #endif // PANEL_H
@@ -2,12 +2,14 @@
 #define STATESNAPSHOT_H
 
 #include <chrono>
+#include <memory>
 #include <string>
 #include <vector>
 
 #include "AppState.h"
+#include "Core/ReconnectScheduler.h"
+#include "Core/SongHistory.h"
 #include "RadioStream.h"
-#include "nlohmann/json.hpp"
 
 // A plain-old-data struct containing only what the UI needs to render a single station.
 struct StationDisplayData {
@@ -24,12 +26,43 @@ struct StationDisplayData {
     int pending_bitrate; // For displaying during URL cycle
     size_t url_count;
     double volume_offset; // For normalization UI
+    bool is_unreachable;  // Every URL failed its health probes
+    ReconnectState reconnect_state;
+    int reconnect_failures; // Stream drops since the station was loaded
+
+    bool operator==(const StationDisplayData& other) const {
+        return name == other.name && current_title == other.current_title && bitrate == other.bitrate &&
+               current_volume == other.current_volume && is_initialized == other.is_initialized &&
+               is_favorite == other.is_favorite && is_buffering == other.is_buffering &&
+               playback_state == other.playback_state && cycling_state == other.cycling_state &&
+               pending_title == other.pending_title && pending_bitrate == other.pending_bitrate &&
+               url_count == other.url_count && volume_offset == other.volume_offset &&
+               is_unreachable == other.is_unreachable && reconnect_state == other.reconnect_state &&
+               reconnect_failures == other.reconnect_failures;
+    }
+};
+
+// One row of the station finder's result list.
+struct StationSearchRow {
+    int station_idx;
+    StationDisplayData station;
+};
+
+// One row of the history search's result list.
+struct HistorySearchRow {
+    HistoryTimeLabel time_label;
+    std::string station_name;
+    std::string title;
 };
 
 // A struct to hold a guaranteed-consistent snapshot of ALL data needed for the UI.
 struct StateSnapshot {
+    // Only the window of stations the list can currently show, not the whole list.
+    // stations[i] is station number station_window_start + i.
     std::vector<StationDisplayData> stations;
-    int active_station_idx;
+    int station_window_start = 0;
+    int total_station_count = 0;
+    int active_station_idx; // Index into the full list, not the window
     ActivePanel active_panel;
     AppMode app_mode;
     bool is_copy_mode_active;
@@ -37,12 +70,30 @@ struct StateSnapshot {
     int history_scroll_offset;
     HopperMode hopper_mode;
     double current_volume_for_header;
-    nlohmann::json active_station_history;
+    std::vector<HistoryDisplayRow> active_station_history; // Newest first, from history_scroll_offset
+    std::shared_ptr<const void> history_titles;            // Keeps active_station_history's titles alive
     int auto_hop_remaining_seconds;
     int auto_hop_total_duration;
     std::string temporary_status_message;      // New field for UI feedback
     bool is_volume_offset_mode_active = false; // Is the offset slider visible?
     bool is_fetching_stations = false;         // Is a fetch for random stations in progress?
+
+    // Search ('/' finds stations, 'h' searches history); results match search_scope
+    bool is_search_active = false;
+    int search_requests_handled = 0;
+    SearchScope search_scope = SearchScope::STATIONS;
+    std::string search_query;
+    int search_selected = 0;
+    std::vector<StationSearchRow> station_search_results; // Best match first
+    std::vector<HistorySearchRow> history_search_results; // Newest first
+
+    // The active station's display data, or nullptr if there is none.
+    const StationDisplayData* activeStation() const {
+        int window_idx = active_station_idx - station_window_start;
+        if (active_station_idx < 0 || window_idx < 0 || window_idx >= (int) stations.size())
+            return nullptr;
+        return &stations[window_idx];
+    }
 };
 
 #endif // STATESNAPSHOT_H
@@ -4,19 +4,28 @@
 #include <string>
 #include <vector>
 
-#include "UI/Panel.h"
+#include "UI/ListPanel.h"
 
 // Forward declarations
 struct StationDisplayData;
+struct StationSearchRow;
 
-class StationsPanel : public Panel {
+class StationsPanel : public ListPanel {
   public:
     StationsPanel();
-    void draw(const std::vector<StationDisplayData>& stations, int active_station_idx, bool is_focused);
+    // `stations` is a window of the full list starting at `window_start`.
+    void draw(const std::vector<StationDisplayData>& stations,
+              int window_start,
+              int total_station_count,
+              int active_station_idx,
+              bool is_focused);
+    // Replaces the list with the '/' finder's query and ranked matches.
+    void drawSearch(const std::string& query, const std::vector<StationSearchRow>& results, int selected);
+    int getVisibleRows() const { return m_h > 2 ? m_h - 2 : 0; }
 
   private:
     std::string getStationStatusString(const StationDisplayData& station) const;
-    void drawStationLine(int y, const StationDisplayData& station, bool is_selected, int inner_w);
+    ListLine formatStationLine(const StationDisplayData& station, bool is_selected, int inner_w) const;
 
     int m_station_scroll_offset;
 };
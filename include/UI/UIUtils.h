@@ -4,10 +4,14 @@
 #include <ncurses.h>
 
 #include <string>
+#include <string_view>
 
-std::string truncate_string(const std::string& str, size_t width);
-std::string format_history_timestamp(const std::string& ts_str);
-void draw_box(int y, int x, int w, int h, const std::string& title, bool is_focused);
+// Terminal columns taken by UTF-8 text (wide characters count double).
+size_t display_width(std::string_view str);
+// Cuts UTF-8 text to `width` columns, ending in "..." when shortened. Never splits a character.
+std::string truncate_string(std::string_view str, size_t width);
+// Frames the whole window, with the title set into the top border.
+void draw_box(WINDOW* win, const std::string& title, bool is_focused);
 bool contains_ci(const std::string& haystack, const std::string& needle);
 
 #endif // UIUTILS_H
@@ -13,6 +13,7 @@ class HistoryPanel;
 class HeaderBar;
 class FooterBar;
 class ILayoutStrategy;
+class WakeupSignal;
 struct StateSnapshot; // The one and only data source
 
 class UIManager {
@@ -20,15 +21,38 @@ class UIManager {
     UIManager();
     ~UIManager();
 
-    // The signature is now much simpler. It only needs the snapshot.
+    // Repaints only the panels whose part of the snapshot changed, then
+    // flushes them to the terminal with a single doupdate().
     void draw(const StateSnapshot& snapshot);
 
+    // Blocks until a key arrives, a resize or Ctrl-Z is signalled, `wakeup_fd`
+    // becomes readable or `timeout_ms` passes (-1 waits indefinitely).
+    void waitForEvents(int wakeup_fd, int timeout_ms);
+    // Returns the next key without blocking, or ERR once none are left.
     int getInput();
-    void setInputTimeout(int milliseconds);
     void handleResize();
+    // Rows available to the station list as of the last draw.
+    int getStationViewportRows() const;
+    // Spinners stay still when animations are off (low-bandwidth rendering).
+    void setAnimationsEnabled(bool enabled);
+
+    // Ctrl-Z is routed through here rather than ncurses, so the caller can stop
+    // drawing while the process is stopped or continues in the background.
+    bool takeSuspendRequest();
+    // Restores the terminal and stops the process; returns once it is continued.
+    void suspend();
+    // False while another process group owns the terminal (e.g. after `bg`).
+    bool isForeground() const;
+    // Repaints everything on the next draw, e.g. after returning to the foreground.
+    void invalidateScreen();
 
   private:
     void updateLayoutStrategy(int width);
+    // Recomputes panel geometry, but only after a resize or a layout-affecting mode change.
+    void updateLayout(const StateSnapshot& snapshot);
+
+    int m_io_stats_fd = -1; // The UI thread's I/O counters, for the bytes-per-frame metric
+    std::unique_ptr<WakeupSignal> m_signal_wakeup;
 
     // UI Components
     std::unique_ptr<HeaderBar> m_header_bar;
@@ -40,10 +64,18 @@ class UIManager {
     // Layout Strategy
     std::unique_ptr<ILayoutStrategy> m_layout_strategy;
     bool m_is_compact_mode;
+    bool m_layout_valid = false;
+    int m_layout_width = 0;
+    int m_layout_height = 0;
+    bool m_layout_auto_hop = false;
 
     // Signal handling for resize is now instance-based
+    static std::atomic<WakeupSignal*> s_signal_wakeup;
+    static void notify_signal_wakeup();
     static std::atomic<bool> s_resize_pending;
     static void resize_handler_trampoline(int signum);
+    static std::atomic<bool> s_suspend_pending;
+    static void suspend_handler_trampoline(int signum);
 };
 
 #endif // UIMANAGER_H
@@ -0,0 +1,96 @@
+#include "CandidateFeed.h"
+
+#include <algorithm>
+#include <iostream>
+#include <iterator>
+
+#include "Core/Metrics.h"
+
+namespace {
+    // The Radio Browser API serves stations in pages of this many.
+    constexpr int PAGE_SIZE = 100;
+}
+
+CandidateFeed::CandidateFeed(PageFetcher fetch_page, int total_limit)
+    : m_fetch_page(std::move(fetch_page)), m_total_limit(total_limit),
+      m_start_time(std::chrono::steady_clock::now()) {
+    m_thread = std::thread(&CandidateFeed::run, this);
+}
+
+CandidateFeed::~CandidateFeed() {
+    m_stop = true;
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+void CandidateFeed::run() {
+    int offset = 0;
+    while (!m_stop) {
+        int page_limit;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_accepted >= m_total_limit)
+                break;
+            page_limit = std::min(PAGE_SIZE, m_total_limit - m_accepted);
+        }
+        size_t entries;
+        try {
+            entries =
+                m_fetch_page(offset, page_limit, [this](CuratorStation station) { deliver(std::move(station)); });
+        } catch (const std::exception& e) {
+            // Ends the feed with what has arrived so far, rather than taking the process down.
+            Metrics::increment("curator.page_fetch_failed");
+            std::cerr << "\nAn error occurred while fetching stations: " << e.what() << std::endl;
+            break;
+        }
+        Metrics::increment("curator.pages_fetched");
+        if (entries < static_cast<size_t>(page_limit))
+            break; // A short page is the last one
+        offset += static_cast<int>(entries);
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_finished = true;
+    m_cond.notify_all();
+    if (m_listener) {
+        m_listener();
+    }
+}
+
+void CandidateFeed::deliver(CuratorStation station) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_accepted >= m_total_limit || !m_seen_uuids.insert(station.stationuuid).second)
+        return;
+    if (m_accepted == 0) {
+        Metrics::recordDuration("curator.first_candidate", std::chrono::steady_clock::now() - m_start_time);
+    }
+    m_arrived.push_back(std::move(station));
+    ++m_accepted;
+    m_cond.notify_all();
+    if (m_listener) {
+        m_listener(); // Under the lock, so it is never called after setListener() returns
+    }
+}
+
+bool CandidateFeed::waitForFirst() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_cond.wait(lock, [this] { return m_accepted > 0 || m_finished; });
+    return m_accepted > 0;
+}
+
+void CandidateFeed::takeArrived(std::vector<CuratorStation>& out) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    out.insert(out.end(), std::make_move_iterator(m_arrived.begin()), std::make_move_iterator(m_arrived.end()));
+    m_arrived.clear();
+}
+
+bool CandidateFeed::isFinished() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_finished;
+}
+
+void CandidateFeed::setListener(std::function<void()> listener) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_listener = std::move(listener);
+}
@@ -6,15 +6,30 @@
 
 #include <algorithm>
 #include <cctype>
+#include <chrono>
+#include <cstdint>
 #include <cstdio>
+#include <ctime>
 #include <fstream>
 #include <iostream>
+#include <limits>
 #include <map>
+#include <memory>
+#include <optional>
+#include <random>
 #include <set>
+#include <sstream>
 #include <stdexcept>
+#include <unordered_map>
 #include <vector>
 
+#include "CandidateFeed.h"
+#include "Core/HistoryIndexFile.h"
+#include "Core/HistorySearchIndex.h"
+#include "Core/Metrics.h"
+#include "Core/StationCatalog.h"
 #include "CuratorApp.h"
+#include "Net/RadioBrowserClient.h"
 #include "PersistenceManager.h"
 #include "Utils.h"
 #include "nlohmann/json.hpp"
@@ -23,25 +38,99 @@ using json = nlohmann::json;
 
 // --- Helper Functions for Parsing API Data ---
 namespace {
+    // The API sends null for some unset fields, which value() would throw on.
+    std::string string_field(const json& entry, const char* key) {
+        auto it = entry.find(key);
+        return it != entry.end() && it->is_string() ? it->get<std::string>() : std::string();
+    }
+
+    int int_field(const json& entry, const char* key) {
+        auto it = entry.find(key);
+        return it != entry.end() && it->is_number() ? it->get<int>() : 0;
+    }
+
+    std::optional<CuratorStation> parse_station_candidate(const json& entry) {
+        if (!entry.is_object()) {
+            return std::nullopt;
+        }
+        CuratorStation station;
+        station.stationuuid = string_field(entry, "stationuuid");
+        station.name = entry.contains("name") ? string_field(entry, "name") : "Unknown";
+        if (auto url = string_field(entry, "url_resolved"); !url.empty()) {
+            station.urls.push_back(url);
+        }
+        station.votes = int_field(entry, "votes");
+        station.country_code = string_field(entry, "countrycode");
+        station.bitrate = int_field(entry, "bitrate");
+        // Left empty when unknown, so it is not filed under any codec.
+        station.format = string_field(entry, "codec");
+        std::istringstream tags(string_field(entry, "tags"));
+        for (std::string tag; std::getline(tags, tag, ',');) {
+            if (!tag.empty()) {
+                station.tags.push_back(tag);
+            }
+        }
+
+        if (station.stationuuid.empty() || station.name.empty() || station.urls.empty()) {
+            return std::nullopt;
+        }
+        return station;
+    }
+
     std::vector<CuratorStation> parse_station_candidates(const json& stations_json) {
         std::vector<CuratorStation> candidates;
         if (!stations_json.is_array()) {
             return candidates;
         }
         for (const auto& entry : stations_json) {
-            CuratorStation station;
-            station.stationuuid = entry.value("stationuuid", "");
-            station.name = entry.value("name", "Unknown");
-            if (entry.contains("url_resolved") && !entry.at("url_resolved").is_null()) {
-                station.urls.push_back(entry.at("url_resolved").get<std::string>());
+            if (auto station = parse_station_candidate(entry)) {
+                candidates.push_back(std::move(*station));
             }
-            station.votes = entry.value("votes", 0);
+        }
+        return candidates;
+    }
+
+    // A station from a full dump or a change listing, for the local catalog.
+    struct CatalogEntry {
+        CuratorStation station;
+        std::time_t changed = 0;
+        bool working = true; // False once the API's last check of the stream failed
+    };
 
-            if (!station.stationuuid.empty() && !station.name.empty() && !station.urls.empty()) {
-                candidates.push_back(station);
+    std::optional<CatalogEntry> parse_catalog_entry(const json& entry) {
+        auto station = parse_station_candidate(entry);
+        if (!station) {
+            return std::nullopt;
+        }
+        CatalogEntry catalog_entry;
+        catalog_entry.station = std::move(*station);
+        std::tm changed{};
+        std::string iso_time = string_field(entry, "lastchangetime_iso8601");
+        if (strptime(iso_time.c_str(), "%Y-%m-%dT%H:%M:%S", &changed)) {
+            catalog_entry.changed = timegm(&changed);
+        }
+        auto check = entry.find("lastcheckok");
+        catalog_entry.working = check == entry.end() || !check->is_number() || check->get<int>() != 0;
+        return catalog_entry;
+    }
+
+    // Parses a JSON array of objects, handing each to `on_entry` as soon as it
+    // closes and then dropping it, so the whole array is never held in memory.
+    // Returns how many entries were seen, or nullopt if the input was malformed.
+    std::optional<size_t> stream_json_entries(std::istream& in, const std::function<void(const json&)>& on_entry) {
+        size_t entries = 0;
+        auto on_event = [&](int depth, json::parse_event_t event, json& parsed) {
+            if (depth == 1 && event == json::parse_event_t::object_end) {
+                ++entries;
+                on_entry(parsed);
+                return false;
             }
+            return true;
+        };
+        if (json::parse(in, on_event, false).is_discarded()) {
+            return std::nullopt;
         }
-        return candidates;
+        return entries;
     }
 
     std::string normalize_tag(std::string tag) {
@@ -139,6 +228,13 @@ namespace {
         return final_list;
     }
 
+    constexpr int MAX_CURATION_LIMIT = 5000;
+    // Changed stations fetched per request by --refresh-catalog.
+    constexpr int CATALOG_REFRESH_PAGE_SIZE = 1000;
+
+    // Most recent matches printed by --search-history; the total is always reported.
+    constexpr size_t HISTORY_SEARCH_PRINT_LIMIT = 100;
+
     void suppress_stderr() {
         int dev_null = open("/dev/null", O_WRONLY);
         if (dev_null == -1)
@@ -148,17 +244,34 @@ namespace {
     }
 } // namespace
 
+CliHandler::CliHandler() : m_api(std::make_unique<RadioBrowserClient>()) {}
+
+CliHandler::~CliHandler() = default;
+
+const StationCatalog* CliHandler::catalog() {
+    std::call_once(m_catalog_opened, [this] {
+        auto local = std::make_unique<StationCatalog>();
+        if (PersistenceManager().openStationCatalog(*local) && local->stationCount() > 0) {
+            m_catalog = std::move(local);
+        }
+    });
+    return m_catalog.get();
+}
+
 std::vector<CuratorStation> CliHandler::get_random_stations(int limit) {
+    if (const StationCatalog* local = catalog()) {
+        auto start = std::chrono::steady_clock::now();
+        std::mt19937 rng(std::random_device{}());
+        std::vector<CuratorStation> stations;
+        for (std::uint32_t id : local->sample(static_cast<size_t>(std::max(0, limit)), rng)) {
+            stations.push_back(local->station(id));
+        }
+        Metrics::recordDuration("catalog.lookup", std::chrono::steady_clock::now() - start);
+        return stations;
+    }
     try {
         std::string path = "/json/stations/search?order=random&hidebroken=true&limit=" + std::to_string(limit);
-        std::string command = "./build/api_helper.sh '" + path + "'";
-        std::string stations_json_str = exec_process(command.c_str());
-
-        if (stations_json_str.empty() || stations_json_str.rfind("Error:", 0) == 0) {
-            std::cerr << "Error fetching random stations: " << stations_json_str << std::endl;
-            return {};
-        }
-        json stations_json = json::parse(stations_json_str);
+        json stations_json = json::parse(m_api->get(path));
         return parse_station_candidates(stations_json);
     } catch (const std::exception& e) {
         std::cerr << "\nAn error occurred while fetching random stations: " << e.what() << std::endl;
@@ -169,14 +282,7 @@ std::vector<CuratorStation> CliHandler::get_random_stations(int limit) {
 std::vector<std::string> CliHandler::get_curated_tags() {
     try {
         std::string path = "/json/tags?order=stationcount&reverse=true&hidebroken=true";
-        std::string command = "./build/api_helper.sh '" + path + "'";
-        std::string raw_json_str = exec_process(command.c_str());
-
-        if (raw_json_str.empty() || raw_json_str.rfind("Error:", 0) == 0) {
-            std::cerr << "Error fetching tags: " << raw_json_str << std::endl;
-            return {};
-        }
-        json raw_tags = json::parse(raw_json_str);
+        json raw_tags = json::parse(m_api->get(path));
         return curate_tags(raw_tags);
     } catch (const std::exception& e) {
         std::cerr << "\nAn error occurred while fetching tags: " << e.what() << std::endl;
@@ -202,20 +308,46 @@ void CliHandler::handle_list_tags() {
     }
 }
 
+size_t CliHandler::stream_curation_candidates(const std::string& genre,
+                                              int offset,
+                                              int limit,
+                                              const std::function<void(CuratorStation)>& on_candidate) {
+    if (const StationCatalog* local = catalog(); local && local->hasTag(genre)) {
+        auto start = std::chrono::steady_clock::now();
+        CatalogFilter filter;
+        filter.tag = genre;
+        auto ids = local->find(filter, static_cast<size_t>(offset), static_cast<size_t>(limit));
+        Metrics::recordDuration("catalog.lookup", std::chrono::steady_clock::now() - start);
+        for (std::uint32_t id : ids) {
+            on_candidate(local->station(id));
+        }
+        return ids.size();
+    }
+
+    std::string encoded_genre = url_encode(genre, UrlEncodingStyle::PATH_PERCENT);
+    std::string path = "/json/stations/bytag/" + encoded_genre + "?order=votes&reverse=true&hidebroken=true&limit=" +
+                       std::to_string(limit) + "&offset=" + std::to_string(offset);
+    std::optional<size_t> entries;
+    m_api->get(path, [&](std::istream& body) {
+        entries = stream_json_entries(body, [&](const json& entry) {
+            if (auto station = parse_station_candidate(entry)) {
+                on_candidate(std::move(*station));
+            }
+        });
+    });
+    if (!entries) {
+        std::cerr << "Error fetching stations for genre '" << genre << "'." << std::endl;
+        return 0;
+    }
+    return *entries;
+}
+
 std::vector<CuratorStation> CliHandler::get_curation_candidates(const std::string& genre) {
     try {
-        std::string encoded_genre = url_encode(genre, UrlEncodingStyle::PATH_PERCENT);
-        std::string path =
-            "/json/stations/bytag/" + encoded_genre + "?order=votes&reverse=true&hidebroken=true&limit=100";
-        std::string command = "./build/api_helper.sh '" + path + "'";
-        std::string stations_json_str = exec_process(command.c_str());
-
-        if (stations_json_str.empty() || stations_json_str.rfind("Error:", 0) == 0) {
-            std::cerr << "Error fetching stations for genre '" << genre << "': " << stations_json_str << std::endl;
-            return {};
-        }
-        json stations_json = json::parse(stations_json_str);
-        return parse_station_candidates(stations_json);
+        std::vector<CuratorStation> candidates;
+        stream_curation_candidates(genre, 0, DEFAULT_CURATION_LIMIT,
+                                   [&](CuratorStation station) { candidates.push_back(std::move(station)); });
+        return candidates;
     } catch (const std::exception& e) {
         std::cerr << "\nAn error occurred while fetching stations for genre '" << genre << "': " << e.what()
                   << std::endl;
@@ -223,19 +355,23 @@ std::vector<CuratorStation> CliHandler::get_curation_candidates(const std::strin
     }
 }
 
-void CliHandler::handle_curate_genre(const std::string& genre) {
+void CliHandler::handle_curate_genre(const std::string& genre, int limit) {
+    limit = std::clamp(limit, 1, MAX_CURATION_LIMIT);
     std::cout << "Fetching stations for genre: '" << genre << "'..." << std::endl;
     try {
-        std::vector<CuratorStation> candidates = get_curation_candidates(genre);
-
-        if (candidates.empty()) {
+        // The session starts on the first parsed candidate; the rest page in behind it.
+        CandidateFeed feed(
+            [this, genre](int offset, int page_limit, const CandidateFeed::Emit& emit) {
+                return stream_curation_candidates(genre, offset, page_limit, emit);
+            },
+            limit);
+        if (!feed.waitForFirst()) {
             std::cout << "No stations found for the genre '" << genre << "'." << std::endl;
             return;
         }
-        std::cout << "Successfully fetched " << candidates.size() << " station candidates." << std::endl;
 
         suppress_stderr();
-        CuratorApp app(genre, std::move(candidates));
+        CuratorApp app(genre, feed);
         app.run();
 
         std::string genre_filename = genre + ".jsonc";
@@ -248,3 +384,177 @@ void CliHandler::handle_curate_genre(const std::string& genre) {
         std::cerr << "\nAn error occurred during curation: " << e.what() << std::endl;
     }
 }
+
+void CliHandler::handle_search_history(const std::string& query) {
+    const auto query_words = HistorySearchIndex::tokenize(query);
+    if (query_words.empty()) {
+        std::cerr << "Error: --search-history needs at least one word to search for." << std::endl;
+        return;
+    }
+
+    struct Match {
+        std::string timestamp;
+        std::string station_name;
+        std::string title;
+    };
+    std::vector<Match> matches;
+    size_t scanned = 0;
+    size_t total_matches = 0;
+    auto start = std::chrono::steady_clock::now();
+
+    PersistenceManager persistence;
+    HistoryIndexFile index;
+    if (persistence.openHistoryIndex(index)) {
+        // The index the app keeps next to the history answers without reading it.
+        auto hits = index.search(query, std::numeric_limits<size_t>::max());
+        total_matches = hits.size();
+        scanned = index.occurrenceCount();
+        hits.resize(std::min(hits.size(), HISTORY_SEARCH_PRINT_LIMIT));
+        for (const auto& hit : hits) {
+            matches.push_back({SongHistory::formatTimestamp(hit.timestamp),
+                               std::string(index.stationName(hit.station_id)), std::string(index.title(hit.title_id))});
+        }
+    } else {
+        // No usable index (e.g. the history was edited by hand): stream the file
+        // entry by entry, keeping only the matches in memory.
+        persistence.scanHistory(
+            [&](const std::string& station_name, const std::string& timestamp, const std::string& title) {
+                ++scanned;
+                if (HistorySearchIndex::titleMatches(query_words, title)) {
+                    matches.push_back({timestamp, station_name, title});
+                }
+            });
+        // "YYYY-mm-dd HH:MM:SS" sorts chronologically as a string.
+        std::stable_sort(matches.begin(), matches.end(),
+                         [](const Match& a, const Match& b) { return a.timestamp > b.timestamp; });
+        total_matches = matches.size();
+    }
+    double elapsed_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    if (matches.empty()) {
+        std::cout << "No songs matching '" << query << "' in " << scanned << " history entries." << std::endl;
+        return;
+    }
+    size_t shown = std::min(matches.size(), HISTORY_SEARCH_PRINT_LIMIT);
+    for (size_t i = 0; i < shown; ++i) {
+        std::cout << matches[i].timestamp << "  " << matches[i].title << "  @ " << matches[i].station_name
+                  << std::endl;
+    }
+    std::cout << "\n" << total_matches << " match(es) in " << scanned << " entries (" << static_cast<long>(elapsed_ms)
+              << " ms)";
+    if (shown < total_matches) {
+        std::cout << ", showing the " << shown << " most recent";
+    }
+    std::cout << "." << std::endl;
+}
+
+void CliHandler::handle_import_catalog(const std::string& dump_filename) {
+    std::ifstream dump(dump_filename);
+    if (!dump.is_open()) {
+        std::cerr << "Error: Could not open '" << dump_filename << "'." << std::endl;
+        return;
+    }
+    std::cout << "Importing stations from '" << dump_filename << "'..." << std::endl;
+    auto start = std::chrono::steady_clock::now();
+    std::vector<CuratorStation> stations;
+    std::time_t newest_change = 0;
+    size_t skipped = 0;
+    auto entries = stream_json_entries(dump, [&](const json& entry) {
+        auto parsed = parse_catalog_entry(entry);
+        if (!parsed || !parsed->working) {
+            ++skipped;
+            return;
+        }
+        newest_change = std::max(newest_change, parsed->changed);
+        stations.push_back(std::move(parsed->station));
+    });
+    if (!entries) {
+        std::cerr << "Error: '" << dump_filename << "' is not a Radio Browser station list (a JSON array)."
+                  << std::endl;
+        return;
+    }
+    try {
+        size_t imported = stations.size();
+        PersistenceManager().saveStationCatalog(std::move(stations), newest_change);
+        double elapsed_ms =
+            std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "Imported " << imported << " stations (" << skipped << " broken or incomplete skipped) in "
+                  << static_cast<long>(elapsed_ms) << " ms." << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << "\nAn error occurred while saving the catalog: " << e.what() << std::endl;
+    }
+}
+
+void CliHandler::handle_refresh_catalog() {
+    PersistenceManager persistence;
+    StationCatalog current;
+    std::unordered_map<std::string, CuratorStation> stations;
+    std::time_t newest_change = 0;
+    size_t changed = 0;
+    size_t removed = 0;
+    auto apply = [&](CatalogEntry entry) {
+        newest_change = std::max(newest_change, entry.changed);
+        if (entry.working) {
+            stations[entry.station.stationuuid] = std::move(entry.station);
+            ++changed;
+        } else {
+            removed += stations.erase(entry.station.stationuuid);
+        }
+    };
+
+    try {
+        if (persistence.openStationCatalog(current)) {
+            for (std::uint32_t id = 0; id < current.stationCount(); ++id) {
+                auto station = current.station(id);
+                stations.emplace(station.stationuuid, std::move(station));
+            }
+            const std::time_t known_change = current.newestChange();
+            newest_change = known_change;
+            std::cout << "Fetching station changes for " << stations.size() << " catalog stations..." << std::endl;
+
+            // Newest changes first; paging stops at the first change the catalog already has.
+            bool caught_up = false;
+            for (int offset = 0; !caught_up; offset += CATALOG_REFRESH_PAGE_SIZE) {
+                std::string path = "/json/stations/search?order=changetimestamp&reverse=true&hidebroken=false&limit=" +
+                                   std::to_string(CATALOG_REFRESH_PAGE_SIZE) + "&offset=" + std::to_string(offset);
+                std::optional<size_t> entries;
+                m_api->get(path, [&](std::istream& body) {
+                    entries = stream_json_entries(body, [&](const json& entry) {
+                        auto parsed = parse_catalog_entry(entry);
+                        if (!parsed || caught_up)
+                            return;
+                        if (parsed->changed < known_change) {
+                            caught_up = true; // Changes in the same second are applied again, harmlessly
+                            return;
+                        }
+                        apply(std::move(*parsed));
+                    });
+                });
+                if (!entries || *entries < static_cast<size_t>(CATALOG_REFRESH_PAGE_SIZE)) {
+                    break;
+                }
+            }
+        } else {
+            std::cout << "No local catalog yet; downloading every station (this may take a minute)..." << std::endl;
+            m_api->get("/json/stations?hidebroken=true", [&](std::istream& body) {
+                stream_json_entries(body, [&](const json& entry) {
+                    if (auto parsed = parse_catalog_entry(entry)) {
+                        apply(std::move(*parsed));
+                    }
+                });
+            });
+        }
+
+        std::vector<CuratorStation> updated;
+        updated.reserve(stations.size());
+        for (auto& [uuid, station] : stations) {
+            updated.push_back(std::move(station));
+        }
+        size_t total = updated.size();
+        persistence.saveStationCatalog(std::move(updated), newest_change);
+        std::cout << "Catalog updated: " << changed << " stations added or changed, " << removed << " removed, "
+                  << total << " in total." << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << "\nAn error occurred while refreshing the catalog: " << e.what() << std::endl;
+    }
+}
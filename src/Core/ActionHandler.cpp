@@ -1,11 +1,15 @@
 #include "Core/ActionHandler.h"
 
+#include <algorithm>
 #include <chrono>
-#include <future>
+#include <cstdlib> // For std::abs
 #include <utility> // For std::move
 #include <variant>
 
-#include "CliHandler.h"
+#include "Core/HistorySearchIndex.h"
+#include "Core/Metrics.h"
+#include "Core/RandomStationQueue.h"
+#include "Core/StationSearchIndex.h"
 #include "Core/VolumeNormalizer.h"
 #include "RadioStream.h"
 #include "SessionState.h"
@@ -15,20 +19,29 @@
 namespace {
     constexpr int FADE_TIME_MS = 900;
     constexpr double DUCK_VOLUME = 40.0;
-    constexpr int PENDING_INSTANCE_ID_OFFSET = 10000;
     constexpr double VOLUME_ADJUST_AMOUNT = 1.0;
-    constexpr int RANDOM_STATIONS_FETCH_BATCH_SIZE = 50; // Fetch more to account for duplicates
     constexpr int RANDOM_STATIONS_FETCH_THRESHOLD = 5;
+    // Finder results shown, and how many of the best are kept preloaded while typing.
+    constexpr size_t STATION_SEARCH_MAX_RESULTS = 50;
+    constexpr size_t STATION_SEARCH_WARM_COUNT = 3;
+    constexpr size_t HISTORY_SEARCH_MAX_RESULTS = 200;
 }
 
 void ActionHandler::process_action(StationManager& manager, const StationManagerMessage& msg) {
+    // Anything but more navigation acts on the station under the cursor, so it
+    // gets the preload window a settling cursor would have committed.
+    if (manager.m_session_state.window_commit_deadline && !std::holds_alternative<Msg::NavigateBy>(msg)) {
+        manager.updateActiveWindow();
+    }
     std::visit(
         [this, &manager](auto&& arg) {
             using T = std::decay_t<decltype(arg)>;
             if constexpr (std::is_same_v<T, Msg::NavigateUp>)
-                handle_navigate(manager, NavDirection::UP);
+                handle_navigate(manager, -1);
             else if constexpr (std::is_same_v<T, Msg::NavigateDown>)
-                handle_navigate(manager, NavDirection::DOWN);
+                handle_navigate(manager, 1);
+            else if constexpr (std::is_same_v<T, Msg::NavigateBy>)
+                handle_navigate(manager, arg.steps);
             else if constexpr (std::is_same_v<T, Msg::ToggleMute>)
                 handle_toggleMute(manager);
             else if constexpr (std::is_same_v<T, Msg::ToggleAutoHop>)
@@ -55,20 +68,32 @@ void ActionHandler::process_action(StationManager& manager, const StationManager
                 handle_adjustVolumeOffset(manager, VOLUME_ADJUST_AMOUNT);
             else if constexpr (std::is_same_v<T, Msg::AdjustVolumeOffsetDown>)
                 handle_adjustVolumeOffset(manager, -VOLUME_ADJUST_AMOUNT);
+            else if constexpr (std::is_same_v<T, Msg::OpenSearch>)
+                handle_openSearch(manager, arg.scope);
+            else if constexpr (std::is_same_v<T, Msg::SearchType>)
+                handle_searchType(manager, arg.ch);
+            else if constexpr (std::is_same_v<T, Msg::SearchBackspace>)
+                handle_searchBackspace(manager);
+            else if constexpr (std::is_same_v<T, Msg::SearchMove>)
+                handle_searchMove(manager, arg.delta);
+            else if constexpr (std::is_same_v<T, Msg::SearchConfirm>)
+                handle_searchConfirm(manager);
+            else if constexpr (std::is_same_v<T, Msg::SearchCancel>)
+                handle_searchCancel(manager);
         },
         msg);
 }
 
 void ActionHandler::handle_fetchMoreRandomStations(StationManager& manager) {
     if (manager.m_is_fetching_random_stations) {
-        return; // Already fetching
-    }
-    manager.m_is_fetching_random_stations = true;
-    manager.m_fetch_is_for_append = true;
-    manager.m_random_stations_future = std::async(std::launch::async, []() {
-        CliHandler cli_handler;
-        return cli_handler.get_random_stations(RANDOM_STATIONS_FETCH_BATCH_SIZE);
-    });
+        return; // Already waiting on the queue
+    }
+    if (!manager.takeRandomStations(true)) {
+        // UpdateManager appends them once the queue refills
+        Metrics::increment("random.queue_misses");
+        manager.m_is_fetching_random_stations = true;
+        manager.m_fetch_is_for_append = true;
+    }
 }
 
 void ActionHandler::handle_enterRandomMode(StationManager& manager) {
@@ -76,16 +101,14 @@ void ActionHandler::handle_enterRandomMode(StationManager& manager) {
         return;
     }
     manager.m_session_state.app_mode = AppMode::RANDOM;
-    manager.m_is_fetching_random_stations = true;
-    manager.m_fetch_is_for_append = false;
-    manager.m_seen_random_station_uuids.clear();
-    manager.m_random_stations_future = std::async(std::launch::async, []() {
-        CliHandler cli_handler;
-        return cli_handler.get_random_stations(RANDOM_STATIONS_FETCH_BATCH_SIZE);
-    });
-
-    // Clear existing stations and show loading state
-    manager.resetWithNewStations({});
+    manager.m_random_station_queue->start(); // Only on first use, so sessions that never enter random mode skip it
+    if (!manager.takeRandomStations(false)) {
+        // Nothing prefetched yet: clear existing stations and show loading state
+        Metrics::increment("random.queue_misses");
+        manager.m_is_fetching_random_stations = true;
+        manager.m_fetch_is_for_append = false;
+        manager.resetWithNewStations({});
+    }
 }
 
 void ActionHandler::handle_adjustVolumeOffset(StationManager& manager, double amount) {
@@ -102,7 +125,7 @@ void ActionHandler::handle_adjustVolumeOffset(StationManager& manager, double am
         return;
     }
     manager.m_volume_normalizer->adjust(manager, station, amount);
-    manager.m_needs_redraw = true;
+    manager.requestRedraw();
 }
 
 void ActionHandler::handle_searchOnline(StationManager& manager, char key) {
@@ -127,13 +150,13 @@ void ActionHandler::handle_searchOnline(StationManager& manager, char key) {
     if (!execute_open_command(full_url, error_message)) {
         manager.m_session_state.temporary_status_message = std::move(error_message);
         manager.m_session_state.temporary_message_end_time = std::chrono::steady_clock::now() + std::chrono::seconds(3);
-        manager.m_needs_redraw = true;
+        manager.requestRedraw();
     } else {
         manager.m_session_state.songs_copied++;
     }
 }
 
-void ActionHandler::handle_navigateStations(StationManager& manager, NavDirection direction) {
+void ActionHandler::handle_navigateStations(StationManager& manager, int steps) {
     if (manager.m_session_state.active_station_idx >= 0 &&
         manager.m_session_state.active_station_idx < (int) manager.m_stations.size()) {
         auto& current_station_obj = manager.m_stations[manager.m_session_state.active_station_idx];
@@ -142,43 +165,49 @@ void ActionHandler::handle_navigateStations(StationManager& manager, NavDirectio
         }
     }
 
-    if (manager.m_stations.empty())
+    if (manager.m_stations.empty() || steps == 0)
         return;
     int station_count = manager.m_stations.size();
     int old_idx = manager.m_session_state.active_station_idx;
     int new_idx = old_idx;
 
-    if (direction == NavDirection::DOWN) {
-        new_idx = old_idx + 1;
-        if (manager.m_session_state.app_mode == AppMode::CURATED && new_idx >= station_count) {
-            new_idx = 0; // Wrap around in curated mode
-        } else if (new_idx >= station_count) {
-            new_idx = station_count - 1; // Don't go past the end in random mode
-        }
-    } else { // NavDirection::UP
-        new_idx = old_idx - 1;
-        if (manager.m_session_state.app_mode == AppMode::CURATED && new_idx < 0) {
-            new_idx = station_count - 1; // Wrap around
-        } else if (new_idx < 0) {
-            new_idx = 0; // Don't go past the start
-        }
+    if (manager.m_session_state.app_mode == AppMode::CURATED) {
+        new_idx = ((old_idx + steps) % station_count + station_count) % station_count; // Wrap around
+    } else {
+        new_idx = std::clamp(old_idx + steps, 0, station_count - 1); // Don't go past either end in random mode
     }
 
+    auto now = std::chrono::steady_clock::now();
     if (new_idx != old_idx) {
         RadioStream& current_station = manager.m_stations[old_idx];
         if (current_station.isInitialized() && current_station.getPlaybackState() != PlaybackState::Muted) {
             manager.fadeAudio(old_idx, 0.0, FADE_TIME_MS, false);
         }
         manager.m_session_state.session_switches++;
-        manager.m_session_state.last_switch_time = std::chrono::steady_clock::now();
+        manager.m_session_state.last_switch_time = now;
     }
 
+    // A move shortly after the previous one is part of a burst: only the
+    // cursor moves now, and the preloader sees where it comes to rest.
+    auto& nav_history = manager.m_session_state.nav_history;
+    bool in_burst = manager.m_session_state.window_commit_deadline.has_value() ||
+                    (!nav_history.empty() && now - nav_history.back().timestamp < manager.m_nav_settle_delay);
+
     manager.m_session_state.active_station_idx = new_idx;
-    manager.m_session_state.nav_history.push_back({direction, std::chrono::steady_clock::now()});
-    if (manager.m_session_state.nav_history.size() > manager.MAX_NAV_HISTORY) {
-        manager.m_session_state.nav_history.pop_front();
+    // One event per step, so the preloader still sees how fast the cursor is moving.
+    NavDirection direction = steps > 0 ? NavDirection::DOWN : NavDirection::UP;
+    size_t events = std::min<size_t>(std::abs(steps), manager.MAX_NAV_HISTORY);
+    for (size_t i = 0; i < events; ++i) {
+        nav_history.push_back({direction, now});
+    }
+    while (nav_history.size() > manager.MAX_NAV_HISTORY) {
+        nav_history.pop_front();
+    }
+    if (in_burst && manager.m_nav_settle_delay.count() > 0) {
+        manager.m_session_state.window_commit_deadline = now + manager.m_nav_settle_delay;
+    } else {
+        manager.updateActiveWindow();
     }
-    manager.updateActiveWindow();
     manager.m_session_state.history_scroll_offset = 0;
 
     // Check if we need to fetch more stations
@@ -188,32 +217,25 @@ void ActionHandler::handle_navigateStations(StationManager& manager, NavDirectio
     }
 }
 
-void ActionHandler::handle_navigateHistory(StationManager& manager, NavDirection direction) {
-    size_t history_size = 0;
+void ActionHandler::handle_navigateHistory(StationManager& manager, int steps) {
+    int history_size = 0;
     if (!manager.m_stations.empty()) {
         const auto& name = manager.m_stations[manager.m_session_state.active_station_idx].getName();
-        if (manager.m_song_history->contains(name)) {
-            history_size = (*manager.m_song_history)[name].size();
-        }
-    }
-    if (direction == NavDirection::UP) {
-        if (manager.m_session_state.history_scroll_offset > 0)
-            manager.m_session_state.history_scroll_offset--;
-    } else {
-        if (history_size > 0 && manager.m_session_state.history_scroll_offset < (int) history_size - 1)
-            manager.m_session_state.history_scroll_offset++;
+        history_size = manager.m_song_history->countFor(name);
     }
+    int& offset = manager.m_session_state.history_scroll_offset;
+    offset = std::clamp(offset + steps, 0, std::max(0, history_size - 1));
 }
 
-void ActionHandler::handle_navigate(StationManager& manager, NavDirection direction) {
+void ActionHandler::handle_navigate(StationManager& manager, int steps) {
     if (manager.m_session_state.hopper_mode == HopperMode::FOCUS)
         manager.m_session_state.hopper_mode = HopperMode::BALANCED;
     if (manager.m_session_state.active_panel == ActivePanel::STATIONS) {
-        handle_navigateStations(manager, direction);
+        handle_navigateStations(manager, steps);
     } else {
-        handle_navigateHistory(manager, direction);
+        handle_navigateHistory(manager, steps);
     }
-    manager.m_needs_redraw = true;
+    manager.requestRedraw();
 }
 
 void ActionHandler::handle_cycleUrl(StationManager& manager) {
@@ -224,8 +246,9 @@ void ActionHandler::handle_cycleUrl(StationManager& manager) {
     if (station.getCyclingState() != CyclingState::IDLE || station.getAllUrls().size() <= 1)
         return;
 
+    station.endRace(); // A manual cycle takes over from any race still running
     station.startCycle();
-    manager.m_needs_redraw = true;
+    manager.requestRedraw();
 
     MpvInstance& pending_instance = station.getPendingMpvInstance();
     pending_instance.initialize(station.getNextUrl());
@@ -234,7 +257,7 @@ void ActionHandler::handle_cycleUrl(StationManager& manager) {
     const char* cmd[] = {"loadfile", station.getNextUrl().c_str(), "replace", nullptr};
     check_mpv_error(mpv_command_async(pending_instance.get(), 0, cmd), "loadfile for pending cycle");
 
-    const int reply_id = station.getID() + PENDING_INSTANCE_ID_OFFSET;
+    const auto reply_id = RadioStream::PENDING_REPLY_ID;
     check_mpv_error(mpv_observe_property(pending_instance.get(), reply_id, "media-title", MPV_FORMAT_STRING),
                     "observe pending media-title");
     check_mpv_error(mpv_observe_property(pending_instance.get(), reply_id, "audio-bitrate", MPV_FORMAT_INT64),
@@ -259,7 +282,7 @@ void ActionHandler::handle_toggleMute(StationManager& manager) {
         station.setMuteStartTime();
         manager.fadeAudio(manager.m_session_state.active_station_idx, 0.0, FADE_TIME_MS / 2, false);
     }
-    manager.m_needs_redraw = true;
+    manager.requestRedraw();
 }
 
 void ActionHandler::handle_toggleAutoHop(StationManager& manager) {
@@ -277,15 +300,19 @@ void ActionHandler::handle_toggleAutoHop(StationManager& manager) {
             }
         }
     }
-    manager.m_needs_redraw = true;
+    manager.requestRedraw();
 }
 
 void ActionHandler::handle_toggleFavorite(StationManager& manager) {
     if (manager.m_session_state.active_station_idx >= 0 &&
         manager.m_session_state.active_station_idx < (int) manager.m_stations.size()) {
-        manager.m_stations[manager.m_session_state.active_station_idx].toggleFavorite();
+        RadioStream& station = manager.m_stations[manager.m_session_state.active_station_idx];
+        station.toggleFavorite();
+        if (!manager.m_startup_data_applied) {
+            manager.m_favorites_toggled_early.insert(station.getName());
+        }
     }
-    manager.m_needs_redraw = true;
+    manager.requestRedraw();
 }
 
 void ActionHandler::handle_toggleDucking(StationManager& manager) {
@@ -303,7 +330,7 @@ void ActionHandler::handle_toggleDucking(StationManager& manager) {
         station.setPlaybackState(PlaybackState::Ducked);
         manager.fadeAudio(manager.m_session_state.active_station_idx, DUCK_VOLUME, FADE_TIME_MS, false);
     }
-    manager.m_needs_redraw = true;
+    manager.requestRedraw();
 }
 
 void ActionHandler::handle_toggleCopyMode(StationManager& manager) {
@@ -311,7 +338,7 @@ void ActionHandler::handle_toggleCopyMode(StationManager& manager) {
     if (manager.m_session_state.copy_mode_active) {
         manager.m_session_state.copy_mode_start_time = std::chrono::steady_clock::now();
     }
-    manager.m_needs_redraw = true;
+    manager.requestRedraw();
 }
 
 void ActionHandler::handle_toggleHopperMode(StationManager& manager) {
@@ -319,11 +346,160 @@ void ActionHandler::handle_toggleHopperMode(StationManager& manager) {
                                               ? HopperMode::BALANCED
                                               : HopperMode::PERFORMANCE;
     manager.updateActiveWindow();
-    manager.m_needs_redraw = true;
+    manager.requestRedraw();
 }
 
 void ActionHandler::handle_switchPanel(StationManager& manager) {
     manager.m_session_state.active_panel =
         (manager.m_session_state.active_panel == ActivePanel::STATIONS) ? ActivePanel::HISTORY : ActivePanel::STATIONS;
-    manager.m_needs_redraw = true;
+    manager.requestRedraw();
+}
+
+void ActionHandler::handle_jumpToStation(StationManager& manager, int new_idx) {
+    if (new_idx < 0 || new_idx >= (int) manager.m_stations.size())
+        return;
+    int old_idx = manager.m_session_state.active_station_idx;
+    if (new_idx != old_idx && old_idx >= 0 && old_idx < (int) manager.m_stations.size()) {
+        RadioStream& current_station = manager.m_stations[old_idx];
+        if (current_station.getCyclingState() != CyclingState::IDLE) {
+            current_station.finalizeCycle(false);
+        }
+        if (current_station.isInitialized() && current_station.getPlaybackState() != PlaybackState::Muted) {
+            manager.fadeAudio(old_idx, 0.0, FADE_TIME_MS, false);
+        }
+        manager.m_session_state.session_switches++;
+        manager.m_session_state.last_switch_time = std::chrono::steady_clock::now();
+    }
+    // A jump is not a scroll, so it must not feed the preloader's acceleration.
+    manager.m_session_state.active_station_idx = new_idx;
+    manager.m_session_state.history_scroll_offset = 0;
+    manager.updateActiveWindow();
+}
+
+void ActionHandler::handle_openSearch(StationManager& manager, SearchScope scope) {
+    manager.m_session_state.search_requests_handled++;
+    close_search(manager);
+    manager.m_session_state.search_active = true;
+    manager.m_session_state.search_scope = scope;
+    manager.requestRedraw();
+}
+
+void ActionHandler::handle_searchType(StationManager& manager, char ch) {
+    if (!manager.m_session_state.search_active)
+        return;
+    manager.m_session_state.search_query.push_back(ch);
+    refresh_search(manager);
+}
+
+void ActionHandler::handle_searchBackspace(StationManager& manager) {
+    std::string& query = manager.m_session_state.search_query;
+    if (!manager.m_session_state.search_active || query.empty())
+        return;
+    // Drop a whole UTF-8 character, not just its last byte.
+    while (!query.empty() && (static_cast<unsigned char>(query.back()) & 0xC0) == 0x80) {
+        query.pop_back();
+    }
+    if (!query.empty()) {
+        query.pop_back();
+    }
+    refresh_search(manager);
+}
+
+void ActionHandler::handle_searchMove(StationManager& manager, int delta) {
+    auto& state = manager.m_session_state;
+    size_t result_count = state.search_scope == SearchScope::STATIONS ? state.station_search_results.size()
+                                                                       : state.history_search_results.size();
+    if (!state.search_active || result_count == 0)
+        return;
+    state.search_selected = std::clamp(state.search_selected + delta, 0, static_cast<int>(result_count) - 1);
+    update_search_warm_set(manager);
+    manager.requestRedraw();
+}
+
+void ActionHandler::handle_searchConfirm(StationManager& manager) {
+    auto& state = manager.m_session_state;
+    state.search_requests_handled++;
+    if (!state.search_active)
+        return;
+    int target = selected_search_station(manager);
+    close_search(manager);
+    if (target >= 0) {
+        if (state.hopper_mode == HopperMode::FOCUS)
+            state.hopper_mode = HopperMode::BALANCED;
+        handle_jumpToStation(manager, target);
+    } else {
+        manager.updateActiveWindow(); // Release the warmed stations
+    }
+    manager.requestRedraw();
+}
+
+void ActionHandler::handle_searchCancel(StationManager& manager) {
+    manager.m_session_state.search_requests_handled++;
+    if (!manager.m_session_state.search_active)
+        return;
+    close_search(manager);
+    manager.updateActiveWindow(); // Release the warmed stations
+    manager.requestRedraw();
+}
+
+void ActionHandler::refresh_search(StationManager& manager) {
+    auto& state = manager.m_session_state;
+    if (state.search_scope == SearchScope::STATIONS) {
+        state.station_search_results =
+            manager.m_station_search_index->search(state.search_query, STATION_SEARCH_MAX_RESULTS);
+    } else {
+        state.history_search_results =
+            manager.m_history_search_index->search(state.search_query, HISTORY_SEARCH_MAX_RESULTS);
+    }
+    state.search_selected = 0;
+    update_search_warm_set(manager);
+    manager.requestRedraw();
+}
+
+// Keeps the best few matches and the selected one preloaded, so confirming the
+// search starts audio immediately without touching the stations in between.
+void ActionHandler::update_search_warm_set(StationManager& manager) {
+    auto& state = manager.m_session_state;
+    std::vector<int> warm;
+    if (state.search_scope == SearchScope::STATIONS) {
+        for (size_t i = 0; i < state.station_search_results.size() && i < STATION_SEARCH_WARM_COUNT; ++i) {
+            warm.push_back(state.station_search_results[i]);
+        }
+    }
+    int selected = selected_search_station(manager);
+    if (selected >= 0 && std::find(warm.begin(), warm.end(), selected) == warm.end()) {
+        warm.push_back(selected);
+    }
+    if (warm != state.warm_station_indices) {
+        state.warm_station_indices = std::move(warm);
+        manager.updateActiveWindow();
+    }
+}
+
+// The station the current selection leads to, or -1. A history hit may name a
+// station that is not in the loaded list.
+int ActionHandler::selected_search_station(const StationManager& manager) const {
+    const auto& state = manager.m_session_state;
+    if (state.search_scope == SearchScope::STATIONS) {
+        if (state.search_selected < (int) state.station_search_results.size())
+            return state.station_search_results[state.search_selected];
+        return -1;
+    }
+    if (state.search_selected >= (int) state.history_search_results.size())
+        return -1;
+    const std::string& station_name =
+        manager.m_history_search_index->stationName(state.history_search_results[state.search_selected].station_id);
+    auto it = std::find_if(manager.m_stations.begin(), manager.m_stations.end(),
+                           [&](const RadioStream& station) { return station.getName() == station_name; });
+    return it != manager.m_stations.end() ? static_cast<int>(std::distance(manager.m_stations.begin(), it)) : -1;
+}
+
+void ActionHandler::close_search(StationManager& manager) {
+    auto& state = manager.m_session_state;
+    state.search_active = false;
+    state.search_query.clear();
+    state.station_search_results.clear();
+    state.history_search_results.clear();
+    state.search_selected = 0;
+    state.warm_station_indices.clear();
 }
@@ -0,0 +1,54 @@
+#include "Core/BinaryFile.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+void BinaryWriter::putStringRef(std::string_view str, std::string& pool) {
+    put(static_cast<std::uint32_t>(pool.size()));
+    put(static_cast<std::uint32_t>(str.size()));
+    pool.append(str);
+}
+
+MappedFile::~MappedFile() { close(); }
+
+bool MappedFile::open(const std::string& filename, size_t min_size) {
+    close();
+    int fd = ::open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info{};
+    if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < min_size) {
+        ::close(fd);
+        return false;
+    }
+    void* mapping = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd); // The mapping keeps the file alive
+    if (mapping == MAP_FAILED) {
+        return false;
+    }
+    m_data = static_cast<const unsigned char*>(mapping);
+    m_size = static_cast<size_t>(info.st_size);
+    return true;
+}
+
+void MappedFile::close() {
+    if (m_data) {
+        munmap(const_cast<unsigned char*>(m_data), m_size);
+    }
+    m_data = nullptr;
+    m_size = 0;
+    m_pool = 0;
+    m_pool_size = 0;
+}
+
+std::string_view MappedFile::stringAt(size_t ref_offset) const {
+    const auto offset = read<std::uint32_t>(ref_offset);
+    const auto length = read<std::uint32_t>(ref_offset + sizeof(std::uint32_t));
+    if (offset > m_pool_size || length > m_pool_size - offset) {
+        return {};
+    }
+    return {reinterpret_cast<const char*>(m_data + m_pool + offset), length};
+}
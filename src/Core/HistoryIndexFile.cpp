@@ -0,0 +1,254 @@
+#include "Core/HistoryIndexFile.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <map>
+
+#include "Core/SongHistory.h"
+
+// Layout, following the conventions in Core/BinaryFile.h:
+//   header            magic "SHHI", version, source size/mtime, section counts
+//   stations          {u32 offset, u32 length} into the string pool, per station id
+//   titles            {u32 offset, u32 length}, per title id
+//   title_occurrences u32[title_count + 1]; title t owns occurrences [t], [t + 1])
+//   occurrences       {i64 timestamp, u32 station_id, u32 unused}, newest first per title
+//   words             {u32 offset, u32 length, u32 postings begin, u32 postings end}, sorted
+//   postings          u32 title ids, ascending per word
+//   strings           the string pool
+namespace {
+    constexpr char INDEX_MAGIC[4] = {'S', 'H', 'H', 'I'};
+    constexpr std::uint32_t INDEX_VERSION = 1;
+
+    constexpr size_t HEADER_SIZE = 4 + 4 + 8 + 8 + 8 + 6 * 4;
+    constexpr size_t OCCURRENCE_SIZE = 16;
+    constexpr size_t WORD_SIZE = 16;
+}
+
+std::string HistoryIndexFile::serialize(const SongHistory& history, const HistoryIndexSource& source) {
+    struct Occurrence {
+        std::time_t timestamp;
+        std::uint32_t station_id;
+    };
+
+    const auto title_count = static_cast<std::uint32_t>(history.titleCount());
+    std::vector<const std::string*> station_names;
+    std::vector<std::vector<Occurrence>> occurrences(title_count);
+    size_t occurrence_count = 0;
+    for (const auto& [station_name, entries] : history.stations()) {
+        const auto station_id = static_cast<std::uint32_t>(station_names.size());
+        station_names.push_back(&station_name);
+        for (const auto& entry : entries) {
+            occurrences[entry.title_id].push_back({entry.timestamp, station_id});
+        }
+        occurrence_count += entries.size();
+    }
+
+    // Titles are visited in id order, so every posting list comes out sorted.
+    std::map<std::string, std::vector<std::uint32_t>> postings;
+    size_t posting_count = 0;
+    for (std::uint32_t id = 0; id < title_count; ++id) {
+        auto words = HistorySearchIndex::tokenize(history.title(id));
+        std::sort(words.begin(), words.end());
+        words.erase(std::unique(words.begin(), words.end()), words.end());
+        for (auto& word : words) {
+            postings[std::move(word)].push_back(id);
+        }
+        posting_count += words.size();
+    }
+
+    std::string pool;
+    BinaryWriter writer;
+    writer.put(INDEX_MAGIC);
+    writer.put(INDEX_VERSION);
+    writer.put(source.size);
+    writer.put(source.mtime_sec);
+    writer.put(source.mtime_nsec);
+    writer.put(static_cast<std::uint32_t>(station_names.size()));
+    writer.put(title_count);
+    writer.put(static_cast<std::uint32_t>(occurrence_count));
+    writer.put(static_cast<std::uint32_t>(postings.size()));
+    writer.put(static_cast<std::uint32_t>(posting_count));
+    const size_t pool_size_pos = writer.size();
+    writer.put(std::uint32_t{0}); // Patched once the pool is complete
+
+    for (const std::string* name : station_names) {
+        writer.putStringRef(*name, pool);
+    }
+    for (std::uint32_t id = 0; id < title_count; ++id) {
+        writer.putStringRef(history.title(id), pool);
+    }
+    std::uint32_t next_occurrence = 0;
+    for (const auto& plays : occurrences) {
+        writer.put(next_occurrence);
+        next_occurrence += static_cast<std::uint32_t>(plays.size());
+    }
+    writer.put(next_occurrence);
+    for (auto& plays : occurrences) {
+        std::stable_sort(plays.begin(), plays.end(),
+                         [](const Occurrence& a, const Occurrence& b) { return a.timestamp > b.timestamp; });
+        for (const auto& play : plays) {
+            writer.put(static_cast<std::int64_t>(play.timestamp));
+            writer.put(play.station_id);
+            writer.put(std::uint32_t{0});
+        }
+    }
+    std::uint32_t next_posting = 0;
+    for (const auto& [word, titles] : postings) {
+        writer.putStringRef(word, pool);
+        writer.put(next_posting);
+        next_posting += static_cast<std::uint32_t>(titles.size());
+        writer.put(next_posting);
+    }
+    for (const auto& [word, titles] : postings) {
+        for (std::uint32_t id : titles) {
+            writer.put(id);
+        }
+    }
+
+    writer.patch(pool_size_pos, static_cast<std::uint32_t>(pool.size()));
+    writer.putBytes(pool.data(), pool.size());
+    return writer.take();
+}
+
+bool HistoryIndexFile::open(const std::string& filename, const HistoryIndexSource& expected) {
+    m_sections = Sections{};
+    if (!m_file.open(filename, HEADER_SIZE)) {
+        return false;
+    }
+
+    char magic[sizeof(INDEX_MAGIC)];
+    BinaryReader header(m_file.data(), 0);
+    header.getBytes(magic, sizeof(magic));
+    std::uint32_t version = 0;
+    HistoryIndexSource stored{};
+    std::uint32_t strings_size = 0;
+    Sections s;
+    header.get(version);
+    header.get(stored.size);
+    header.get(stored.mtime_sec);
+    header.get(stored.mtime_nsec);
+    header.get(s.station_count);
+    header.get(s.title_count);
+    header.get(s.occurrence_count);
+    header.get(s.word_count);
+    header.get(s.posting_count);
+    header.get(strings_size);
+
+    if (std::memcmp(magic, INDEX_MAGIC, sizeof(magic)) != 0 || version != INDEX_VERSION ||
+        stored.size != expected.size || stored.mtime_sec != expected.mtime_sec ||
+        stored.mtime_nsec != expected.mtime_nsec) {
+        m_file.close(); // Foreign, outdated or built from an older history
+        return false;
+    }
+
+    s.stations = HEADER_SIZE;
+    s.titles = s.stations + size_t{s.station_count} * STRING_REF_SIZE;
+    s.title_occurrences = s.titles + size_t{s.title_count} * STRING_REF_SIZE;
+    s.occurrences = s.title_occurrences + (size_t{s.title_count} + 1) * sizeof(std::uint32_t);
+    s.words = s.occurrences + size_t{s.occurrence_count} * OCCURRENCE_SIZE;
+    s.postings = s.words + size_t{s.word_count} * WORD_SIZE;
+    s.strings = s.postings + size_t{s.posting_count} * sizeof(std::uint32_t);
+    s.strings_size = strings_size;
+    if (s.strings + s.strings_size != m_file.size()) {
+        m_file.close();
+        return false;
+    }
+    m_file.setStringPool(s.strings, s.strings_size);
+    m_sections = s;
+    return true;
+}
+
+std::string_view HistoryIndexFile::stationName(std::uint32_t station_id) const {
+    if (!m_file.isOpen() || station_id >= m_sections.station_count)
+        return {};
+    return m_file.stringAt(m_sections.stations + size_t{station_id} * STRING_REF_SIZE);
+}
+
+std::string_view HistoryIndexFile::title(std::uint32_t title_id) const {
+    if (!m_file.isOpen() || title_id >= m_sections.title_count)
+        return {};
+    return m_file.stringAt(m_sections.titles + size_t{title_id} * STRING_REF_SIZE);
+}
+
+size_t HistoryIndexFile::occurrenceCount() const { return m_sections.occurrence_count; }
+
+// Appends the ids of every title holding a word that starts with `word`.
+void HistoryIndexFile::collectWordTitles(const std::string& word, std::vector<std::uint32_t>& out) const {
+    auto word_at = [this](std::uint32_t i) { return m_file.stringAt(m_sections.words + size_t{i} * WORD_SIZE); };
+
+    std::uint32_t low = 0;
+    std::uint32_t high = m_sections.word_count;
+    while (low < high) {
+        std::uint32_t mid = low + (high - low) / 2;
+        if (word_at(mid) < word) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    for (std::uint32_t i = low; i < m_sections.word_count; ++i) {
+        if (word_at(i).compare(0, word.size(), word) != 0)
+            break;
+        const size_t record = m_sections.words + size_t{i} * WORD_SIZE;
+        const auto begin = m_file.read<std::uint32_t>(record + 8);
+        const auto end = m_file.read<std::uint32_t>(record + 12);
+        if (begin > end || end > m_sections.posting_count)
+            continue;
+        for (std::uint32_t p = begin; p < end; ++p) {
+            out.push_back(m_file.read<std::uint32_t>(m_sections.postings + size_t{p} * sizeof(std::uint32_t)));
+        }
+    }
+}
+
+std::vector<HistorySearchHit> HistoryIndexFile::search(const std::string& query, size_t max_results) const {
+    std::vector<HistorySearchHit> hits;
+    const auto query_words = HistorySearchIndex::tokenize(query);
+    if (!m_file.isOpen() || query_words.empty() || max_results == 0) {
+        return hits;
+    }
+
+    std::vector<std::uint32_t> matched;
+    bool first_word = true;
+    for (const auto& word : query_words) {
+        std::vector<std::uint32_t> word_titles;
+        collectWordTitles(word, word_titles);
+        std::sort(word_titles.begin(), word_titles.end());
+        word_titles.erase(std::unique(word_titles.begin(), word_titles.end()), word_titles.end());
+
+        if (first_word) {
+            matched = std::move(word_titles);
+            first_word = false;
+        } else {
+            std::vector<std::uint32_t> narrowed;
+            std::set_intersection(matched.begin(), matched.end(), word_titles.begin(), word_titles.end(),
+                                  std::back_inserter(narrowed));
+            matched = std::move(narrowed);
+        }
+        if (matched.empty()) {
+            return hits;
+        }
+    }
+
+    for (std::uint32_t title_id : matched) {
+        if (title_id >= m_sections.title_count)
+            continue;
+        const size_t bounds = m_sections.title_occurrences + size_t{title_id} * sizeof(std::uint32_t);
+        const auto begin = m_file.read<std::uint32_t>(bounds);
+        const auto end = m_file.read<std::uint32_t>(bounds + sizeof(std::uint32_t));
+        if (begin > end || end > m_sections.occurrence_count)
+            continue;
+        for (std::uint32_t o = begin; o < end; ++o) {
+            const size_t record = m_sections.occurrences + size_t{o} * OCCURRENCE_SIZE;
+            const auto station_id = m_file.read<std::uint32_t>(record + 8);
+            if (station_id < m_sections.station_count) {
+                hits.push_back({static_cast<std::time_t>(m_file.read<std::int64_t>(record)), station_id, title_id});
+            }
+        }
+    }
+    auto newer = [](const HistorySearchHit& a, const HistorySearchHit& b) { return a.timestamp > b.timestamp; };
+    size_t count = std::min(max_results, hits.size());
+    std::partial_sort(hits.begin(), hits.begin() + count, hits.end(), newer);
+    hits.resize(count);
+    return hits;
+}
@@ -0,0 +1,131 @@
+#include "Core/HistorySearchIndex.h"
+
+#include <algorithm>
+#include <cctype>
+#include <iterator>
+
+#include "Core/SongHistory.h"
+
+std::vector<std::string> HistorySearchIndex::tokenize(const std::string& text) {
+    std::vector<std::string> words;
+    std::string word;
+    for (char c : text) {
+        auto uc = static_cast<unsigned char>(c);
+        if (uc >= 0x80 || std::isalnum(uc)) {
+            word.push_back(static_cast<char>(std::tolower(uc)));
+        } else if (!word.empty()) {
+            words.push_back(std::move(word));
+            word.clear();
+        }
+    }
+    if (!word.empty()) {
+        words.push_back(std::move(word));
+    }
+    return words;
+}
+
+bool HistorySearchIndex::titleMatches(const std::vector<std::string>& query_words, const std::string& title) {
+    if (query_words.empty())
+        return false;
+    const auto title_words = tokenize(title);
+    return std::all_of(query_words.begin(), query_words.end(), [&](const std::string& query_word) {
+        return std::any_of(title_words.begin(), title_words.end(), [&](const std::string& title_word) {
+            return title_word.compare(0, query_word.size(), query_word) == 0;
+        });
+    });
+}
+
+void HistorySearchIndex::clear() {
+    m_station_names.clear();
+    m_station_ids.clear();
+    m_occurrences.clear();
+    m_postings.clear();
+}
+
+void HistorySearchIndex::rebuild(const SongHistory& history) {
+    clear();
+    // Index titles in id order first, so every posting list stays sorted.
+    m_occurrences.resize(history.titleCount());
+    for (std::uint32_t id = 0; id < history.titleCount(); ++id) {
+        indexTitle(id, history.title(id));
+    }
+    for (const auto& [station_name, entries] : history.stations()) {
+        for (const auto& entry : entries) {
+            add(station_name, entry.timestamp, entry.title_id, history.title(entry.title_id));
+        }
+    }
+}
+
+void HistorySearchIndex::indexTitle(std::uint32_t title_id, const std::string& title) {
+    auto words = tokenize(title);
+    std::sort(words.begin(), words.end());
+    words.erase(std::unique(words.begin(), words.end()), words.end());
+    for (const auto& word : words) {
+        m_postings[word].push_back(title_id);
+    }
+}
+
+void HistorySearchIndex::add(const std::string& station_name,
+                             std::time_t timestamp,
+                             std::uint32_t title_id,
+                             const std::string& title) {
+    // SongHistory hands out title ids sequentially, so a new id is always the next one.
+    if (title_id >= m_occurrences.size()) {
+        m_occurrences.resize(title_id + 1);
+        indexTitle(title_id, title);
+    }
+    auto [it, inserted] = m_station_ids.emplace(station_name, static_cast<std::uint32_t>(m_station_names.size()));
+    if (inserted) {
+        m_station_names.push_back(station_name);
+    }
+    m_occurrences[title_id].push_back({timestamp, it->second});
+}
+
+const std::string& HistorySearchIndex::stationName(std::uint32_t station_id) const {
+    return m_station_names.at(station_id);
+}
+
+std::vector<HistorySearchHit> HistorySearchIndex::search(const std::string& query, size_t max_results) const {
+    std::vector<HistorySearchHit> hits;
+    const auto query_words = tokenize(query);
+    if (query_words.empty() || max_results == 0) {
+        return hits;
+    }
+
+    // Titles matching all words: the intersection of each word's prefix range.
+    std::vector<std::uint32_t> matched;
+    bool first_word = true;
+    for (const auto& word : query_words) {
+        std::vector<std::uint32_t> word_titles;
+        for (auto it = m_postings.lower_bound(word);
+             it != m_postings.end() && it->first.compare(0, word.size(), word) == 0; ++it) {
+            word_titles.insert(word_titles.end(), it->second.begin(), it->second.end());
+        }
+        std::sort(word_titles.begin(), word_titles.end());
+        word_titles.erase(std::unique(word_titles.begin(), word_titles.end()), word_titles.end());
+
+        if (first_word) {
+            matched = std::move(word_titles);
+            first_word = false;
+        } else {
+            std::vector<std::uint32_t> narrowed;
+            std::set_intersection(matched.begin(), matched.end(), word_titles.begin(), word_titles.end(),
+                                  std::back_inserter(narrowed));
+            matched = std::move(narrowed);
+        }
+        if (matched.empty()) {
+            return hits;
+        }
+    }
+
+    for (std::uint32_t title_id : matched) {
+        for (const auto& occurrence : m_occurrences[title_id]) {
+            hits.push_back({occurrence.timestamp, occurrence.station_id, title_id});
+        }
+    }
+    auto newer = [](const HistorySearchHit& a, const HistorySearchHit& b) { return a.timestamp > b.timestamp; };
+    size_t count = std::min(max_results, hits.size());
+    std::partial_sort(hits.begin(), hits.begin() + count, hits.end(), newer);
+    hits.resize(count);
+    return hits;
+}
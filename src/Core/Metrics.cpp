@@ -0,0 +1,85 @@
+#include "Core/Metrics.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <iomanip>
+#include <sstream>
+
+namespace {
+    const char* METRICS_ENV_VAR = "STREAM_HOPPER_METRICS";
+    const char* METRICS_FILENAME = "stream_hopper_metrics.log";
+}
+
+std::mutex Metrics::s_mutex;
+std::map<std::string, long> Metrics::s_counters;
+std::map<std::string, Metrics::Timing> Metrics::s_timings;
+const std::chrono::steady_clock::time_point Metrics::s_process_start = std::chrono::steady_clock::now();
+
+void Metrics::increment(const std::string& name, long amount) {
+    std::lock_guard<std::mutex> lock(s_mutex);
+    s_counters[name] += amount;
+}
+
+void Metrics::recordDuration(const std::string& name, double ms) {
+    std::lock_guard<std::mutex> lock(s_mutex);
+    Timing& t = s_timings[name];
+    t.count++;
+    t.total_ms += ms;
+    t.max_ms = std::max(t.max_ms, ms);
+    t.last_ms = ms;
+}
+
+void Metrics::recordDuration(const std::string& name, std::chrono::steady_clock::duration duration) {
+    recordDuration(name, std::chrono::duration<double, std::milli>(duration).count());
+}
+
+long Metrics::counter(const std::string& name) {
+    std::lock_guard<std::mutex> lock(s_mutex);
+    auto it = s_counters.find(name);
+    return it != s_counters.end() ? it->second : 0;
+}
+
+Metrics::Timing Metrics::timing(const std::string& name) {
+    std::lock_guard<std::mutex> lock(s_mutex);
+    auto it = s_timings.find(name);
+    return it != s_timings.end() ? it->second : Timing{};
+}
+
+double Metrics::msSinceProcessStart() {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - s_process_start).count();
+}
+
+std::string Metrics::report() {
+    std::lock_guard<std::mutex> lock(s_mutex);
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(2);
+    for (const auto& [name, value] : s_counters) {
+        out << name << " = " << value << "\n";
+    }
+    for (const auto& [name, t] : s_timings) {
+        double avg = t.count > 0 ? t.total_ms / t.count : 0.0;
+        out << name << " : count=" << t.count << " avg=" << avg << "ms max=" << t.max_ms << "ms last=" << t.last_ms
+            << "ms\n";
+    }
+    return out.str();
+}
+
+void Metrics::writeReportIfEnabled() {
+    if (getenv(METRICS_ENV_VAR) == nullptr) {
+        return;
+    }
+    FILE* logfile = fopen(METRICS_FILENAME, "a");
+    if (!logfile) {
+        return;
+    }
+    time_t now = time(nullptr);
+    std::tm tm_now{};
+    localtime_r(&now, &tm_now);
+    char dt[30];
+    strftime(dt, sizeof(dt), "%Y-%m-%d %H:%M:%S", &tm_now);
+    std::string body = report();
+    fprintf(logfile, "[%s] Session metrics\n%s\n", dt, body.c_str());
+    fclose(logfile);
+}
@@ -4,14 +4,13 @@
 #include <cmath>
 #include <cstring> // Required for strcmp
 #include <ctime>
-#include <iomanip>
-#include <sstream>
 
+#include "Core/Metrics.h"
+#include "Core/ReconnectScheduler.h"
 #include "RadioStream.h"
 #include "StationManager.h"
 #include "UI/UIUtils.h" // For contains_ci
 #include "Utils.h"      // For check_mpv_error
-#include "nlohmann/json.hpp"
 
 namespace {
     static constexpr char* PROP_NAME_MEDIA_TITLE = (char*) "media-title";
@@ -21,40 +20,70 @@ namespace {
     // PROP_NAME_DEMUXER_STATE was unused, so removed for now.
 
     constexpr int BITRATE_REDRAW_THRESHOLD = 2;
-    constexpr int PENDING_INSTANCE_ID_OFFSET = 10000;
 }
 
 MpvEventHandler::MpvEventHandler(StationManager& manager) : m_manager(manager) {}
 
-void MpvEventHandler::handleEvent(mpv_event* event) {
+void MpvEventHandler::handleEvent(RadioStream& station, mpv_event* event, bool from_pending) {
     if (event->event_id == MPV_EVENT_PROPERTY_CHANGE) {
-        handlePropertyChange(event);
+        handlePropertyChange(station, event);
     } else if (event->event_id == MPV_EVENT_END_FILE) {
         // This logic is specific and small, so it can stay here.
-        if (event->reply_userdata >= PENDING_INSTANCE_ID_OFFSET) {
-            int station_id = event->reply_userdata - PENDING_INSTANCE_ID_OFFSET;
-            if (station_id < (int) m_manager.m_stations.size()) { // The 'station_id >= 0' check is removed here.
-                auto& station = m_manager.m_stations[station_id];
-                if (station.getCyclingState() == CyclingState::CYCLING) {
-                    station.finalizeCycle(false); // Cycle failed on EOF
-                    m_manager.getNeedsRedrawFlag() = true;
-                }
+        if (from_pending) {
+            if (station.getCyclingState() == CyclingState::CYCLING) {
+                station.finalizeCycle(false); // Cycle failed on EOF
+                m_manager.requestRedraw();
             }
+            return;
+        }
+        // A stream that drops mid-play is reported by onEofProperty, but a load that
+        // never connects (e.g. a dead host) only ends the file with an error.
+        auto* end_file = reinterpret_cast<mpv_event_end_file*>(event->data);
+        if (station.isInitialized() && end_file && end_file->reason == MPV_END_FILE_REASON_ERROR) {
+            onStreamEof(station);
         }
-        // Note: EOF for main instance is handled by onEofProperty
     }
 }
 
-void MpvEventHandler::handle_pending_instance_property_change(mpv_event* event, mpv_event_property* prop) {
-    int station_id = event->reply_userdata - PENDING_INSTANCE_ID_OFFSET;
-    if (station_id < 0 || station_id >= (int) m_manager.m_stations.size())
+void MpvEventHandler::handleRacerEvent(RadioStream& station, size_t racer, mpv_event* event) {
+    if (event->event_id == MPV_EVENT_END_FILE) {
+        station.dropRacer(racer); // Lost by failing to connect
         return;
+    }
+    if (event->event_id != MPV_EVENT_PROPERTY_CHANGE) {
+        return;
+    }
+    mpv_event_property* prop = reinterpret_cast<mpv_event_property*>(event->data);
+    if (strcmp(prop->name, PROP_NAME_MEDIA_TITLE) == 0 && prop->format == MPV_FORMAT_STRING) {
+        char* title_cstr = *reinterpret_cast<char**>(prop->data);
+        station.setRacerTitle(racer, title_cstr ? std::string(title_cstr) : "");
+        return;
+    }
+    if (strcmp(prop->name, PROP_NAME_AUDIO_BITRATE) != 0 || prop->format != MPV_FORMAT_INT64) {
+        return;
+    }
+    int bitrate = static_cast<int>(*reinterpret_cast<int64_t*>(prop->data) / 1000);
+    if (bitrate <= 0) {
+        return;
+    }
+    // Only a station still under the cursor and playing fades over to its winner.
+    if (station.getID() != m_manager.m_session_state.active_station_idx ||
+        station.getPlaybackState() != PlaybackState::Playing || station.getCyclingState() != CyclingState::IDLE) {
+        station.endRace();
+        return;
+    }
+    station.promoteRacer(racer);
+    station.setPendingBitrate(bitrate);
+    m_manager.crossFadeToPending(station.getID());
+    mpv_unobserve_property(station.getPendingMpvInstance().get(), RadioStream::PENDING_REPLY_ID);
+    Metrics::increment("race.won_by_backup");
+    m_manager.requestRedraw();
+}
 
-    RadioStream& station = m_manager.m_stations[station_id];
-
+void MpvEventHandler::handle_pending_instance_property_change(RadioStream& station, mpv_event_property* prop) {
     if (station.getCyclingState() != CyclingState::CYCLING) {
         // If no longer cycling, unobserve and ignore. This can happen if the cycle timed out or was cancelled.
-        mpv_unobserve_property(station.getPendingMpvInstance().get(), station_id + PENDING_INSTANCE_ID_OFFSET);
+        mpv_unobserve_property(station.getPendingMpvInstance().get(), RadioStream::PENDING_REPLY_ID);
         return;
     }
 
@@ -76,25 +105,22 @@ void MpvEventHandler::handle_pending_instance_property_change(mpv_event* event,
     }
 
     if (property_changed_for_pending) {
-        m_manager.getNeedsRedrawFlag() = true;
+        m_manager.requestRedraw();
         // If we have both title and bitrate (or just bitrate if title never comes), proceed.
         // The primary trigger for crossfade is getting a valid pending bitrate.
         if (station.getPendingBitrate() > 0) {
-            m_manager.crossFadeToPending(station_id);
+            m_manager.crossFadeToPending(station.getID());
             // Once we start the crossfade, we can stop observing.
             // The finalizeCycle(true) will happen in UpdateManager after fade completes.
-            mpv_unobserve_property(station.getPendingMpvInstance().get(), station_id + PENDING_INSTANCE_ID_OFFSET);
+            mpv_unobserve_property(station.getPendingMpvInstance().get(), RadioStream::PENDING_REPLY_ID);
         }
     }
 }
 
-void MpvEventHandler::handle_main_instance_property_change(mpv_event* event, mpv_event_property* prop) {
-    RadioStream* station_ptr = findStationById(event->reply_userdata);
-    if (!station_ptr || !station_ptr->isInitialized())
+void MpvEventHandler::handle_main_instance_property_change(RadioStream& station, mpv_event_property* prop) {
+    if (!station.isInitialized())
         return;
 
-    RadioStream& station = *station_ptr;
-
     if (strcmp(prop->name, PROP_NAME_MEDIA_TITLE) == 0)
         onTitleProperty(prop, station);
     else if (strcmp(prop->name, PROP_NAME_AUDIO_BITRATE) == 0)
@@ -105,13 +131,14 @@ void MpvEventHandler::handle_main_instance_property_change(mpv_event* event, mpv
         onCoreIdleProperty(prop, station);
 }
 
-void MpvEventHandler::handlePropertyChange(mpv_event* event) {
+void MpvEventHandler::handlePropertyChange(RadioStream& station, mpv_event* event) {
     mpv_event_property* prop = reinterpret_cast<mpv_event_property*>(event->data);
 
-    if (event->reply_userdata >= PENDING_INSTANCE_ID_OFFSET) {
-        handle_pending_instance_property_change(event, prop);
+    // A promoted pending instance keeps its reply id until it is unobserved.
+    if (event->reply_userdata == RadioStream::PENDING_REPLY_ID) {
+        handle_pending_instance_property_change(station, prop);
     } else {
-        handle_main_instance_property_change(event, prop);
+        handle_main_instance_property_change(station, prop);
     }
 }
 
@@ -127,7 +154,7 @@ void MpvEventHandler::onTitleChanged(RadioStream& station, const std::string& ne
     if (contains_ci(station.getActiveUrl(), new_title) || contains_ci(station.getName(), new_title)) {
         if (new_title != station.getCurrentTitle()) { // Still update display if it's just the station name
             station.setCurrentTitle(new_title);
-            m_manager.getNeedsRedrawFlag() = true;
+            m_manager.requestRedraw();
         }
         return;
     }
@@ -138,26 +165,25 @@ void MpvEventHandler::onTitleChanged(RadioStream& station, const std::string& ne
         station.setHasLoggedFirstSong(true);
     }
 
-    auto now = std::chrono::system_clock::now();
-    std::time_t now_c = std::chrono::system_clock::to_time_t(now);
-    std::tm now_tm = *std::localtime(&now_c); // localtime is not thread-safe, but MPV events are on one thread
-    std::stringstream time_ss;
-    time_ss << std::put_time(&now_tm, "%Y-%m-%d %H:%M:%S");
-
-    nlohmann::json history_entry_for_file = {time_ss.str(), title_to_log};
-    m_manager.addHistoryEntry(station.getName(), history_entry_for_file);
+    m_manager.addHistoryEntry(station.getName(), std::time(nullptr), title_to_log);
 
     station.setCurrentTitle(new_title);
-    m_manager.getNeedsRedrawFlag() = true;
+    m_manager.requestRedraw();
 }
 
 void MpvEventHandler::onStreamEof(RadioStream& station) {
-    // This is for the main instance. If a stream ends, try to reconnect.
-    station.setCurrentTitle("Stream Error - Reconnecting...");
+    // This is for the main instance. The reconnect itself waits for the scheduler (see UpdateManager).
+    auto& scheduler = *m_manager.m_reconnect_scheduler;
+    scheduler.onFailure(station.getID(), std::chrono::steady_clock::now());
+    ReconnectStatus status = scheduler.status(station.getID());
+    if (status.state == ReconnectState::PARKED) {
+        station.setCurrentTitle("Stream Error - Gave up after " + std::to_string(status.consecutive_failures) +
+                                " tries");
+    } else {
+        station.setCurrentTitle("Stream Error - Reconnecting...");
+    }
     station.setHasLoggedFirstSong(false); // Reset for the new connection attempt
-    const char* cmd[] = {"loadfile", station.getActiveUrl().c_str(), "replace", nullptr};
-    check_mpv_error(mpv_command_async(station.getMpvHandle(), 0, cmd), "reconnect on eof");
-    m_manager.getNeedsRedrawFlag() = true;
+    m_manager.requestRedraw();
 }
 
 void MpvEventHandler::onTitleProperty(mpv_event_property* prop, RadioStream& station) {
@@ -178,7 +204,7 @@ void MpvEventHandler::onBitrateProperty(mpv_event_property* prop, RadioStream& s
         // Redraw if it's the active station and bitrate changed significantly
         if (station.getID() == m_manager.m_session_state.active_station_idx &&
             std::abs(new_bitrate - old_bitrate) > BITRATE_REDRAW_THRESHOLD) {
-            m_manager.getNeedsRedrawFlag() = true;
+            m_manager.requestRedraw();
         }
     }
 }
@@ -192,18 +218,21 @@ void MpvEventHandler::onEofProperty(mpv_event_property* prop, RadioStream& stati
 void MpvEventHandler::onCoreIdleProperty(mpv_event_property* prop, RadioStream& station) {
     if (prop->format == MPV_FORMAT_FLAG) {
         bool is_idle = *reinterpret_cast<int*>(prop->data);
+        if (!is_idle) {
+            m_manager.m_reconnect_scheduler->onConnected(station.getID());
+        }
+        if (!is_idle && station.isRacing()) {
+            station.endRace(); // The first URL delivered before any racer
+            Metrics::increment("race.won_by_first");
+        }
+        if (!is_idle && station.getID() == m_manager.m_session_state.active_station_idx) {
+            m_manager.onFirstAudio();
+        }
         if (station.isBuffering() != is_idle) {
             station.setBuffering(is_idle);
             if (station.getID() == m_manager.m_session_state.active_station_idx) {
-                m_manager.getNeedsRedrawFlag() = true;
+                m_manager.requestRedraw();
             }
         }
     }
 }
-
-RadioStream* MpvEventHandler::findStationById(int station_id) {
-    auto& stations_vec = m_manager.m_stations; // Use a local ref for clarity
-    auto it = std::find_if(stations_vec.begin(), stations_vec.end(),
-                           [station_id](const RadioStream& s) { return s.getID() == station_id; });
-    return (it != stations_vec.end()) ? &(*it) : nullptr;
-}
@@ -0,0 +1,71 @@
+#include "Core/PersistenceWorker.h"
+
+#include <chrono>
+#include <exception>
+
+#include "Core/Metrics.h"
+
+PersistenceWorker::PersistenceWorker() { m_thread = std::thread(&PersistenceWorker::run, this); }
+
+PersistenceWorker::~PersistenceWorker() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_cond.notify_one();
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+void PersistenceWorker::submit(const std::string& key, WriteJob job) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_pending.find(key);
+        if (it != m_pending.end()) {
+            it->second = std::move(job); // Coalesce: keep the queue position, replace the state
+            Metrics::increment("persist.coalesced");
+        } else {
+            m_pending.emplace(key, std::move(job));
+            m_order.push_back(key);
+        }
+    }
+    m_cond.notify_one();
+}
+
+void PersistenceWorker::flush() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_idle_cond.wait(lock, [this] { return m_order.empty() && !m_is_writing; });
+}
+
+void PersistenceWorker::run() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+        m_cond.wait(lock, [this] { return m_stop || !m_order.empty(); });
+        if (m_order.empty()) {
+            break; // Stopping and fully drained
+        }
+
+        std::string key = std::move(m_order.front());
+        m_order.pop_front();
+        WriteJob job = std::move(m_pending.at(key));
+        m_pending.erase(key);
+        m_is_writing = true;
+        lock.unlock();
+
+        auto start = std::chrono::steady_clock::now();
+        try {
+            job();
+        } catch (const std::exception&) {
+            Metrics::increment("persist.failed." + key);
+        }
+        Metrics::recordDuration("persist.write." + key, std::chrono::steady_clock::now() - start);
+
+        lock.lock();
+        m_is_writing = false;
+        if (m_order.empty()) {
+            m_idle_cond.notify_all();
+        }
+    }
+    m_idle_cond.notify_all();
+}
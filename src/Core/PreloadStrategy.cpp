@@ -14,6 +14,9 @@ namespace {
     constexpr int PRELOAD_EXTRA = 3;
     // How many stations to reduce from the non-accelerating direction.
     constexpr int PRELOAD_REDUCTION = 2;
+    // PERFORMANCE mode preloads everything on a normal list, but a single mpv
+    // instance per station does not scale to generated lists of thousands.
+    constexpr int PERFORMANCE_PRELOAD_RADIUS = 16;
 }
 
 namespace Strategy {
@@ -55,21 +58,45 @@ namespace Strategy {
 
     std::unordered_set<int> Preloader::calculate_active_indices(int active_idx,
                                                                 int station_count,
+                                                                bool wrap_around,
                                                                 HopperMode hopper_mode,
-                                                                const std::deque<NavEvent>& nav_history) const {
+                                                                const std::deque<NavEvent>& nav_history,
+                                                                const std::vector<int>& warm_indices) const {
         std::unordered_set<int> new_active_set;
 
         if (station_count == 0) {
             return new_active_set;
         }
 
+        // Adds the station `offset` places from the active one.
+        auto insert_neighbor = [&](int offset) {
+            int idx = active_idx + offset;
+            if (wrap_around) {
+                new_active_set.insert(((idx % station_count) + station_count) % station_count);
+            } else if (idx >= 0 && idx < station_count) {
+                new_active_set.insert(idx);
+            }
+        };
+
         // Always include the currently active station.
         new_active_set.insert(active_idx);
+        for (int idx : warm_indices) {
+            if (idx >= 0 && idx < station_count) {
+                new_active_set.insert(idx);
+            }
+        }
 
         switch (hopper_mode) {
         case HopperMode::PERFORMANCE:
-            for (int i = 0; i < station_count; ++i) {
-                new_active_set.insert(i);
+            if (station_count <= 2 * PERFORMANCE_PRELOAD_RADIUS + 1) {
+                for (int i = 0; i < station_count; ++i) {
+                    new_active_set.insert(i);
+                }
+            } else {
+                for (int i = 1; i <= PERFORMANCE_PRELOAD_RADIUS; ++i) {
+                    insert_neighbor(-i);
+                    insert_neighbor(i);
+                }
             }
             break;
 
@@ -82,10 +109,10 @@ namespace Strategy {
             auto [preload_up, preload_down] = getPreloadCounts(nav_history);
 
             for (int i = 1; i <= preload_up; ++i) {
-                new_active_set.insert((active_idx - i + station_count) % station_count);
+                insert_neighbor(-i);
             }
             for (int i = 1; i <= preload_down; ++i) {
-                new_active_set.insert((active_idx + i) % station_count);
+                insert_neighbor(i);
             }
             break;
         }
@@ -0,0 +1,212 @@
+#include "Core/RandomStationQueue.h"
+
+#include <netdb.h>
+#include <sys/socket.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <ctime>
+#include <thread>
+#include <unordered_set>
+
+#include "CliHandler.h"
+#include "Core/Metrics.h"
+#include "PersistenceManager.h"
+
+namespace {
+    constexpr int FETCH_BATCH_SIZE = 50; // Fetch more to account for duplicates
+    // A batch is fetched whenever fewer stations than this are queued.
+    constexpr size_t LOW_WATER_MARK = 30;
+    // After an empty fetch, wait before trying again, doubling up to the maximum.
+    constexpr std::chrono::seconds RETRY_DELAY(2);
+    constexpr std::chrono::seconds MAX_RETRY_DELAY(60);
+    // Host lookups in flight at once while checking a batch.
+    constexpr size_t RESOLVER_THREADS = 4;
+
+    // Radio Browser lists about 50k stations; a filter generation sized for
+    // 20k takes about 30 KB per generation at the default rate.
+    constexpr size_t SEEN_FILTER_CAPACITY = 20000;
+    constexpr const char* SEEN_FP_RATE_ENV_VAR = "STREAM_HOPPER_SEEN_FP_RATE";
+    constexpr double DEFAULT_SEEN_FP_RATE = 0.01;
+    constexpr const char* SEEN_EXPIRY_ENV_VAR = "STREAM_HOPPER_SEEN_EXPIRY_DAYS";
+    constexpr int DEFAULT_SEEN_EXPIRY_DAYS = 90;
+
+    SeenStationFilter seen_filter_from_environment() {
+        double rate = DEFAULT_SEEN_FP_RATE;
+        if (const char* value = getenv(SEEN_FP_RATE_ENV_VAR)) {
+            rate = std::clamp(std::atof(value), 0.0001, 0.5);
+        }
+        int days = DEFAULT_SEEN_EXPIRY_DAYS;
+        if (const char* value = getenv(SEEN_EXPIRY_ENV_VAR)) {
+            days = std::max(std::atoi(value), 1);
+        }
+        return SeenStationFilter(SEEN_FILTER_CAPACITY, rate, std::chrono::hours(24 * days));
+    }
+
+    // "http://host:port/path" -> "host"; brackets are stripped from IPv6 literals.
+    std::string host_of(const std::string& url) {
+        size_t start = url.find("://");
+        start = (start == std::string::npos) ? 0 : start + 3;
+        size_t end = url.find_first_of("/?#", start);
+        std::string authority = url.substr(start, end == std::string::npos ? std::string::npos : end - start);
+        if (size_t at = authority.rfind('@'); at != std::string::npos) {
+            authority.erase(0, at + 1);
+        }
+        if (!authority.empty() && authority.front() == '[') {
+            size_t close = authority.find(']');
+            return authority.substr(1, close == std::string::npos ? std::string::npos : close - 1);
+        }
+        return authority.substr(0, authority.find(':'));
+    }
+
+    // Only a definite "no such host" counts; a lookup that merely failed (e.g.
+    // while offline) keeps the station.
+    bool host_resolves(const std::string& host) {
+        if (host.empty()) {
+            return false;
+        }
+        addrinfo hints{};
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;
+        hints.ai_flags = AI_ADDRCONFIG;
+        addrinfo* result = nullptr;
+        int rc = getaddrinfo(host.c_str(), nullptr, &hints, &result);
+        if (result) {
+            freeaddrinfo(result);
+        }
+        return rc != EAI_NONAME;
+    }
+} // namespace
+
+RandomStationQueue::RandomStationQueue() : m_seen(seen_filter_from_environment()) {}
+
+RandomStationQueue::~RandomStationQueue() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_cond.notify_one();
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+void RandomStationQueue::start() {
+    if (!m_thread.joinable()) {
+        m_thread = std::thread(&RandomStationQueue::run, this);
+    }
+}
+
+std::vector<CuratorStation> RandomStationQueue::take(size_t count) {
+    std::vector<CuratorStation> stations;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        const std::time_t now = std::time(nullptr);
+        while (stations.size() < count && !m_queue.empty()) {
+            m_seen.insert(m_queue.front().stationuuid, now);
+            stations.push_back(std::move(m_queue.front()));
+            m_queue.pop_front();
+        }
+    }
+    m_cond.notify_one();
+    return stations;
+}
+
+SeenStationFilter RandomStationQueue::seenStations() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_seen;
+}
+
+bool RandomStationQueue::lastFetchFailed() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_last_fetch_failed;
+}
+
+void RandomStationQueue::run() {
+    SeenStationFilter seen = m_seen;
+    if (!PersistenceManager().loadSeenStations(seen)) {
+        seen = m_seen; // Missing, or saved with other settings: start over
+    }
+    CliHandler cli_handler; // Kept for the session, so its API connections stay open
+    auto retry_delay = RETRY_DELAY;
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_seen = std::move(seen);
+    while (true) {
+        m_cond.wait(lock, [this] { return m_stop || m_queue.size() < LOW_WATER_MARK; });
+        if (m_stop) {
+            break;
+        }
+        lock.unlock();
+
+        auto start = std::chrono::steady_clock::now();
+        auto fetched = cli_handler.get_random_stations(FETCH_BATCH_SIZE);
+        const bool fetch_failed = fetched.empty();
+        auto stations = keepPlayable(std::move(fetched));
+        Metrics::recordDuration("random.prefetch", std::chrono::steady_clock::now() - start);
+
+        lock.lock();
+        m_last_fetch_failed = fetch_failed;
+        for (auto& station : stations) {
+            m_queue.push_back(std::move(station));
+        }
+        if (fetch_failed) {
+            m_cond.wait_for(lock, retry_delay, [this] { return m_stop; });
+            retry_delay = std::min(retry_delay * 2, MAX_RETRY_DELAY);
+        } else {
+            retry_delay = RETRY_DELAY;
+            if (stations.empty()) {
+                // The API answered but everything was filtered out; try another
+                // batch without reporting an error, just not in a tight loop.
+                m_cond.wait_for(lock, RETRY_DELAY, [this] { return m_stop; });
+            }
+        }
+    }
+}
+
+// Drops stations offered before or already queued (the API and the catalog
+// sample with replacement across batches) and stations whose host no longer exists.
+std::vector<CuratorStation> RandomStationQueue::keepPlayable(std::vector<CuratorStation> fetched) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_seen.expire(std::time(nullptr));
+        std::unordered_set<std::string> queued;
+        for (const auto& station : m_queue) {
+            queued.insert(station.stationuuid);
+        }
+        size_t before = fetched.size();
+        fetched.erase(std::remove_if(fetched.begin(), fetched.end(),
+                                     [&](const CuratorStation& s) {
+                                         return s.urls.empty() || m_seen.contains(s.stationuuid) ||
+                                                !queued.insert(s.stationuuid).second;
+                                     }),
+                      fetched.end());
+        Metrics::increment("random.already_seen", static_cast<long>(before - fetched.size()));
+    }
+
+    // Each lookup can take a resolver round trip, so a few workers share the batch.
+    std::vector<char> resolves(fetched.size(), false);
+    std::atomic<size_t> next_lookup{0};
+    auto resolve_next = [&] {
+        for (size_t i = next_lookup++; i < fetched.size(); i = next_lookup++) {
+            resolves[i] = host_resolves(host_of(fetched[i].urls.front()));
+        }
+    };
+    std::vector<std::thread> resolvers;
+    for (size_t i = 0; i < std::min(RESOLVER_THREADS, fetched.size()); ++i) {
+        resolvers.emplace_back(resolve_next);
+    }
+    for (auto& resolver : resolvers) {
+        resolver.join();
+    }
+    std::vector<CuratorStation> playable;
+    for (size_t i = 0; i < fetched.size(); ++i) {
+        if (resolves[i]) {
+            playable.push_back(std::move(fetched[i]));
+        } else {
+            Metrics::increment("random.unresolvable");
+        }
+    }
+    return playable;
+}
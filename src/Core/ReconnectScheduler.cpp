@@ -0,0 +1,101 @@
+#include "Core/ReconnectScheduler.h"
+
+#include <algorithm>
+
+#include "Core/Metrics.h"
+
+namespace {
+    constexpr std::chrono::milliseconds BASE_BACKOFF(1000);
+    constexpr std::chrono::milliseconds MAX_BACKOFF(60000);
+    constexpr int MAX_IN_FLIGHT = 2;
+    // A station failing this often in a row is parked, then gets one attempt per park.
+    constexpr int PARK_AFTER_FAILURES = 6;
+    constexpr std::chrono::minutes PARK_DURATION(10);
+    // A backstop: failed attempts are normally reported as they end. One that
+    // neither plays nor fails by then counts as a failure.
+    constexpr std::chrono::seconds CONNECT_TIMEOUT(20);
+} // namespace
+
+ReconnectScheduler::ReconnectScheduler() : m_rng(std::random_device{}()) {}
+
+void ReconnectScheduler::onFailure(int station_id, Clock::time_point now) {
+    ReconnectStatus& station = m_stations[station_id];
+    if (station.state == ReconnectState::WAITING || station.state == ReconnectState::PARKED) {
+        return; // Already counted; nothing was attempted since
+    }
+    ++station.consecutive_failures;
+    ++station.total_failures;
+    Metrics::increment("reconnect.failures");
+    if (station.consecutive_failures >= PARK_AFTER_FAILURES) {
+        if (station.consecutive_failures == PARK_AFTER_FAILURES) {
+            Metrics::increment("reconnect.parked");
+        }
+        station.state = ReconnectState::PARKED;
+        station.next_attempt = now + PARK_DURATION;
+    } else {
+        station.state = ReconnectState::WAITING;
+        station.next_attempt = now + backoff(station.consecutive_failures);
+    }
+}
+
+void ReconnectScheduler::onConnected(int station_id) {
+    auto it = m_stations.find(station_id);
+    if (it == m_stations.end())
+        return;
+    // The failure count stays for display; only the backoff starts over.
+    it->second.state = ReconnectState::HEALTHY;
+    it->second.consecutive_failures = 0;
+}
+
+std::vector<int> ReconnectScheduler::takeDue(Clock::time_point now) {
+    int in_flight = 0;
+    for (auto& [station_id, station] : m_stations) {
+        if (station.state == ReconnectState::CONNECTING && now >= station.next_attempt + CONNECT_TIMEOUT) {
+            onFailure(station_id, now);
+        }
+        if (station.state == ReconnectState::CONNECTING)
+            ++in_flight;
+    }
+
+    std::vector<int> due;
+    for (auto& [station_id, station] : m_stations) {
+        if (in_flight >= MAX_IN_FLIGHT)
+            break;
+        bool waiting = station.state == ReconnectState::WAITING || station.state == ReconnectState::PARKED;
+        if (waiting && now >= station.next_attempt) {
+            station.state = ReconnectState::CONNECTING;
+            station.next_attempt = now;
+            due.push_back(station_id);
+            ++in_flight;
+        }
+    }
+    Metrics::increment("reconnect.attempts", due.size());
+    return due;
+}
+
+ReconnectStatus ReconnectScheduler::status(int station_id) const {
+    auto it = m_stations.find(station_id);
+    return it != m_stations.end() ? it->second : ReconnectStatus{};
+}
+
+void ReconnectScheduler::forget(int station_id) { m_stations.erase(station_id); }
+
+void ReconnectScheduler::clear() { m_stations.clear(); }
+
+void ReconnectScheduler::dropFront(int count) {
+    std::map<int, ReconnectStatus> shifted;
+    for (auto& [station_id, station] : m_stations) {
+        if (station_id >= count)
+            shifted.emplace(station_id - count, station);
+    }
+    m_stations.swap(shifted);
+}
+
+// Doubles with each failure up to MAX_BACKOFF; the wait is drawn from the upper
+// half of that, so retries spread out without ever coming too soon.
+std::chrono::milliseconds ReconnectScheduler::backoff(int consecutive_failures) {
+    auto nominal = BASE_BACKOFF * (1LL << std::min(consecutive_failures - 1, 16));
+    nominal = std::min<std::chrono::milliseconds>(nominal, MAX_BACKOFF);
+    std::uniform_int_distribution<long long> jitter(nominal.count() / 2, nominal.count());
+    return std::chrono::milliseconds(jitter(m_rng));
+}
@@ -0,0 +1,146 @@
+#include "Core/SeenStationFilter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "Core/BinaryFile.h"
+
+// Layout, in the byte order of Core/BinaryFile.h:
+//   header       magic "SHSF", version, capacity, hash count, bit count,
+//                generation span, generation count
+//   generations  {i64 started, u32 count, u32 unused, u64 bits[bit count / 64]}, oldest first
+namespace {
+    constexpr char FILTER_MAGIC[4] = {'S', 'H', 'S', 'F'};
+    constexpr std::uint32_t FILTER_VERSION = 1;
+    constexpr size_t GENERATIONS = 4;
+
+    constexpr size_t HEADER_SIZE = 4 + 4 + 4 + 4 + 8 + 8 + 4;
+    constexpr size_t GENERATION_HEADER_SIZE = 8 + 4 + 4;
+
+    // Two independent 64-bit hashes; probe i is h1 + i * h2 (Kirsch-Mitzenmacher).
+    struct HashPair {
+        std::uint64_t h1;
+        std::uint64_t h2;
+    };
+
+    HashPair hash_uuid(const std::string& uuid) {
+        std::uint64_t hash = 14695981039346656037ull; // FNV-1a
+        for (unsigned char c : uuid) {
+            hash = (hash ^ c) * 1099511628211ull;
+        }
+        std::uint64_t mixed = hash + 0x9e3779b97f4a7c15ull; // splitmix64 finalizer
+        mixed = (mixed ^ (mixed >> 30)) * 0xbf58476d1ce4e5b9ull;
+        mixed = (mixed ^ (mixed >> 27)) * 0x94d049bb133111ebull;
+        mixed ^= mixed >> 31;
+        return {hash, mixed | 1};
+    }
+} // namespace
+
+SeenStationFilter::SeenStationFilter(size_t capacity, double false_positive_rate, std::chrono::seconds expiry)
+    : m_capacity(static_cast<std::uint32_t>(std::max<size_t>(capacity, 1))),
+      m_generation_span(std::max<std::int64_t>(expiry.count() / GENERATIONS, 1)) {
+    // A lookup checks every generation, so each gets its share of the rate.
+    const double rate = std::clamp(false_positive_rate, 1e-9, 0.5) / GENERATIONS;
+    const double ln2 = std::log(2.0);
+    const double bits = std::ceil(-static_cast<double>(m_capacity) * std::log(rate) / (ln2 * ln2));
+    m_bit_count = (static_cast<std::uint64_t>(bits) + 63) / 64 * 64;
+    m_hash_count = std::max<std::uint32_t>(
+        1, static_cast<std::uint32_t>(std::lround(static_cast<double>(m_bit_count) / m_capacity * ln2)));
+}
+
+bool SeenStationFilter::contains(const std::string& uuid) const {
+    const HashPair hash = hash_uuid(uuid);
+    for (const auto& generation : m_generations) {
+        bool all_set = true;
+        for (std::uint32_t i = 0; i < m_hash_count && all_set; ++i) {
+            std::uint64_t bit = (hash.h1 + i * hash.h2) % m_bit_count;
+            all_set = (generation.bits[bit / 64] >> (bit % 64)) & 1;
+        }
+        if (all_set) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void SeenStationFilter::insert(const std::string& uuid, std::time_t now) {
+    expire(now);
+    if (m_generations.empty() || m_generations.back().count >= m_capacity ||
+        now - m_generations.back().started >= m_generation_span) {
+        startGeneration(now);
+    }
+    Generation& newest = m_generations.back();
+    const HashPair hash = hash_uuid(uuid);
+    for (std::uint32_t i = 0; i < m_hash_count; ++i) {
+        std::uint64_t bit = (hash.h1 + i * hash.h2) % m_bit_count;
+        newest.bits[bit / 64] |= std::uint64_t{1} << (bit % 64);
+    }
+    ++newest.count;
+}
+
+void SeenStationFilter::expire(std::time_t now) {
+    // A generation stops taking uuids one span after it started, and is kept for the rest of the expiry.
+    while (!m_generations.empty() &&
+           now - m_generations.front().started >= m_generation_span * static_cast<std::int64_t>(GENERATIONS)) {
+        m_generations.pop_front();
+    }
+}
+
+void SeenStationFilter::startGeneration(std::time_t now) {
+    if (m_generations.size() >= GENERATIONS) {
+        m_generations.pop_front();
+    }
+    Generation generation;
+    generation.started = now;
+    generation.bits.assign(m_bit_count / 64, 0);
+    m_generations.push_back(std::move(generation));
+}
+
+std::string SeenStationFilter::serialize() const {
+    BinaryWriter writer;
+    writer.reserve(HEADER_SIZE + m_generations.size() * (GENERATION_HEADER_SIZE + m_bit_count / 8));
+    writer.put(FILTER_MAGIC);
+    writer.put(FILTER_VERSION);
+    writer.put(m_capacity);
+    writer.put(m_hash_count);
+    writer.put(m_bit_count);
+    writer.put(m_generation_span);
+    writer.put(static_cast<std::uint32_t>(m_generations.size()));
+    for (const auto& generation : m_generations) {
+        writer.put(generation.started);
+        writer.put(generation.count);
+        writer.put(std::uint32_t{0});
+        writer.putBytes(generation.bits.data(), generation.bits.size() * 8);
+    }
+    return writer.take();
+}
+
+bool SeenStationFilter::deserialize(const std::string& data) {
+    m_generations.clear();
+    if (data.size() < HEADER_SIZE || std::memcmp(data.data(), FILTER_MAGIC, sizeof(FILTER_MAGIC)) != 0) {
+        return false;
+    }
+    BinaryReader reader(data.data(), sizeof(FILTER_MAGIC));
+    if (reader.get<std::uint32_t>() != FILTER_VERSION || reader.get<std::uint32_t>() != m_capacity ||
+        reader.get<std::uint32_t>() != m_hash_count || reader.get<std::uint64_t>() != m_bit_count ||
+        reader.get<std::int64_t>() != m_generation_span) {
+        return false; // Sized for another rate, capacity or expiry
+    }
+    const auto generation_count = reader.get<std::uint32_t>();
+    const size_t generation_size = GENERATION_HEADER_SIZE + m_bit_count / 8;
+    if (generation_count > GENERATIONS || data.size() != HEADER_SIZE + generation_count * generation_size) {
+        return false;
+    }
+
+    std::deque<Generation> generations(generation_count);
+    for (auto& generation : generations) {
+        generation.started = reader.get<std::int64_t>();
+        generation.count = reader.get<std::uint32_t>();
+        reader.skip(4);
+        generation.bits.resize(m_bit_count / 64);
+        reader.getBytes(generation.bits.data(), m_bit_count / 8);
+    }
+    m_generations = std::move(generations);
+    return true;
+}
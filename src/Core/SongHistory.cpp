@@ -0,0 +1,165 @@
+#include "Core/SongHistory.h"
+
+#include <algorithm>
+#include <cstdio>
+
+namespace {
+    constexpr std::time_t SECONDS_PER_DAY = 24 * 60 * 60;
+
+    bool read_digits(const std::string& s, size_t pos, size_t count, int& out) {
+        if (pos + count > s.size())
+            return false;
+        int value = 0;
+        for (size_t i = pos; i < pos + count; ++i) {
+            if (s[i] < '0' || s[i] > '9')
+                return false;
+            value = value * 10 + (s[i] - '0');
+        }
+        out = value;
+        return true;
+    }
+
+    std::time_t local_day_start(std::time_t t) {
+        std::tm tm_local{};
+        localtime_r(&t, &tm_local);
+        tm_local.tm_hour = 0;
+        tm_local.tm_min = 0;
+        tm_local.tm_sec = 0;
+        tm_local.tm_isdst = -1;
+        return std::mktime(&tm_local);
+    }
+}
+
+std::time_t HistoryTimeFormatter::todayStart(std::time_t now) {
+    if (now < m_today_start || now >= m_tomorrow_start) {
+        m_today_start = local_day_start(now);
+        // Ask mktime for the next boundary so DST days of 23/25 hours are handled.
+        m_tomorrow_start = local_day_start(m_today_start + SECONDS_PER_DAY + SECONDS_PER_DAY / 2);
+    }
+    return m_today_start;
+}
+
+void HistoryTimeFormatter::format(std::time_t timestamp, std::time_t today_start, HistoryTimeLabel& out) const {
+    std::tm tm_entry{};
+    localtime_r(&timestamp, &tm_entry);
+    if (timestamp >= today_start) {
+        std::strftime(out.data(), out.size(), "%H:%M", &tm_entry);
+    } else if (timestamp >= today_start - SECONDS_PER_DAY) {
+        std::snprintf(out.data(), out.size(), "Yesterday");
+    } else {
+        std::strftime(out.data(), out.size(), "%b %d", &tm_entry);
+    }
+}
+
+SongHistory::SongHistory(const SongHistory& other)
+    : m_titles(std::make_shared<std::deque<std::string>>(*other.m_titles)), m_title_ids_stale(true),
+      m_by_station(other.m_by_station), m_unparsed(other.m_unparsed) {}
+
+SongHistory& SongHistory::operator=(const SongHistory& other) {
+    if (this != &other) {
+        m_titles = std::make_shared<std::deque<std::string>>(*other.m_titles);
+        m_title_ids.clear();
+        m_title_ids_stale = true;
+        m_by_station = other.m_by_station;
+        m_unparsed = other.m_unparsed;
+        m_label_cache.clear();
+    }
+    return *this;
+}
+
+std::uint32_t SongHistory::intern(const std::string& title) {
+    if (m_title_ids_stale) {
+        m_title_ids.clear();
+        for (size_t i = 0; i < m_titles->size(); ++i) {
+            m_title_ids.emplace((*m_titles)[i], static_cast<std::uint32_t>(i));
+        }
+        m_title_ids_stale = false;
+    }
+    auto it = m_title_ids.find(title);
+    if (it != m_title_ids.end()) {
+        return it->second;
+    }
+    m_titles->push_back(title);
+    auto id = static_cast<std::uint32_t>(m_titles->size() - 1);
+    m_title_ids.emplace(m_titles->back(), id);
+    return id;
+}
+
+std::uint32_t
+SongHistory::add(const std::string& station_name, std::time_t timestamp, const std::string& title) {
+    std::uint32_t title_id = intern(title);
+    m_by_station[station_name].push_back({timestamp, title_id});
+    return title_id;
+}
+
+void SongHistory::addUnparsed(UnparsedHistoryEntry entry) { m_unparsed.push_back(std::move(entry)); }
+
+const SongHistory::Entries& SongHistory::entriesFor(const std::string& station_name) const {
+    static const Entries empty;
+    auto it = m_by_station.find(station_name);
+    return it != m_by_station.end() ? it->second : empty;
+}
+
+size_t SongHistory::countFor(const std::string& station_name) const { return entriesFor(station_name).size(); }
+
+const std::string& SongHistory::title(std::uint32_t title_id) const { return (*m_titles)[title_id]; }
+
+size_t SongHistory::titleCount() const { return m_titles->size(); }
+
+void SongHistory::collectRows(const std::string& station_name,
+                              int skip,
+                              int max_rows,
+                              std::time_t now,
+                              std::vector<HistoryDisplayRow>& rows) const {
+    rows.clear();
+    const Entries& entries = entriesFor(station_name);
+    if (entries.empty() || max_rows <= 0)
+        return;
+
+    std::time_t today_start = m_formatter.todayStart(now);
+    LabelCache& cache = m_label_cache[station_name];
+    if (cache.day != today_start) {
+        cache.labels.clear();
+        cache.day = today_start;
+    }
+    for (size_t i = cache.labels.size(); i < entries.size(); ++i) {
+        HistoryTimeLabel label{};
+        m_formatter.format(entries[i].timestamp, today_start, label);
+        cache.labels.push_back(label);
+    }
+
+    int total = static_cast<int>(entries.size());
+    int first = total - 1 - std::max(0, skip);
+    rows.reserve(std::min(max_rows, std::max(0, first + 1)));
+    for (int i = first; i >= 0 && (int) rows.size() < max_rows; --i) {
+        rows.push_back({cache.labels[i], (*m_titles)[entries[i].title_id]});
+    }
+}
+
+std::time_t SongHistory::parseTimestamp(const std::string& ts_str) {
+    // Fixed layout: "YYYY-mm-dd HH:MM:SS"
+    std::tm tm{};
+    int year = 0, month = 0, day = 0, hour = 0, minute = 0, second = 0;
+    if (ts_str.size() < 19 || ts_str[4] != '-' || ts_str[7] != '-' || ts_str[13] != ':' || ts_str[16] != ':' ||
+        !read_digits(ts_str, 0, 4, year) || !read_digits(ts_str, 5, 2, month) || !read_digits(ts_str, 8, 2, day) ||
+        !read_digits(ts_str, 11, 2, hour) || !read_digits(ts_str, 14, 2, minute) ||
+        !read_digits(ts_str, 17, 2, second)) {
+        return -1;
+    }
+    tm.tm_year = year - 1900;
+    tm.tm_mon = month - 1;
+    tm.tm_mday = day;
+    tm.tm_hour = hour;
+    tm.tm_min = minute;
+    tm.tm_sec = second;
+    tm.tm_isdst = -1;
+    return std::mktime(&tm);
+}
+
+std::string SongHistory::formatTimestamp(std::time_t timestamp) {
+    std::tm tm_local{};
+    localtime_r(&timestamp, &tm_local);
+    char buffer[32];
+    std::strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S", &tm_local);
+    return buffer;
+}
@@ -0,0 +1,353 @@
+#include "Core/StationCatalog.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <map>
+#include <unordered_set>
+
+// Layout (see Core/BinaryFile.h for byte order and string references):
+//   header     magic "SHCT", version, newest change time, section counts
+//   stations   {uuid, name, url, country, codec, tags} string refs + {u32 bitrate, i32 votes},
+//              most voted first
+//   weights    u64 running total of votes + 1, per station, for weighted sampling
+//   by_bitrate u32 station ids, highest bitrate first
+//   tags       {string ref, u32 postings begin, u32 postings end}, sorted by key
+//   countries  same, keyed by country code
+//   codecs     same, keyed by codec
+//   postings   u32 station ids, ascending (so most voted first) per key
+//   strings    the string pool; a station's tags are stored comma-joined
+namespace {
+    constexpr char CATALOG_MAGIC[4] = {'S', 'H', 'C', 'T'};
+    constexpr std::uint32_t CATALOG_VERSION = 1;
+
+    constexpr size_t HEADER_SIZE = 4 + 4 + 8 + 6 * 4;
+    constexpr size_t STATION_SIZE = 6 * STRING_REF_SIZE + 4 + 4;
+    constexpr size_t KEY_SIZE = 16;
+    // Draws allowed per requested station before sampling gives up on duplicates.
+    constexpr size_t SAMPLE_ATTEMPTS_PER_STATION = 8;
+
+    using PostingMap = std::map<std::string, std::vector<std::uint32_t>>;
+
+    std::string normalize_tag(const std::string& tag) {
+        auto begin = tag.find_first_not_of(' ');
+        auto end = tag.find_last_not_of(' ');
+        if (begin == std::string::npos)
+            return {};
+        std::string normalized = tag.substr(begin, end - begin + 1);
+        std::transform(normalized.begin(), normalized.end(), normalized.begin(),
+                       [](unsigned char c) { return std::tolower(c); });
+        return normalized;
+    }
+} // namespace
+
+std::string StationCatalog::serialize(std::vector<CuratorStation> stations, std::time_t newest_change) {
+    std::stable_sort(stations.begin(), stations.end(),
+                     [](const CuratorStation& a, const CuratorStation& b) { return a.votes > b.votes; });
+
+    // Stations are visited in id order, so every posting list comes out sorted.
+    PostingMap tags, countries, codecs;
+    std::vector<std::string> joined_tags(stations.size());
+    for (std::uint32_t id = 0; id < stations.size(); ++id) {
+        const auto& station = stations[id];
+        std::vector<std::string> station_tags;
+        for (const auto& tag : station.tags) {
+            auto normalized = normalize_tag(tag);
+            if (!normalized.empty() && std::find(station_tags.begin(), station_tags.end(), normalized) ==
+                                           station_tags.end()) {
+                station_tags.push_back(std::move(normalized));
+            }
+        }
+        for (const auto& tag : station_tags) {
+            tags[tag].push_back(id);
+            joined_tags[id] += (joined_tags[id].empty() ? "" : ",") + tag;
+        }
+        if (!station.country_code.empty())
+            countries[station.country_code].push_back(id);
+        if (!station.format.empty())
+            codecs[station.format].push_back(id);
+    }
+    size_t posting_count = 0;
+    for (const PostingMap* keys : {&tags, &countries, &codecs}) {
+        for (const auto& [key, ids] : *keys) {
+            posting_count += ids.size();
+        }
+    }
+
+    std::string pool;
+    BinaryWriter writer;
+    writer.put(CATALOG_MAGIC);
+    writer.put(CATALOG_VERSION);
+    writer.put(static_cast<std::int64_t>(newest_change));
+    writer.put(static_cast<std::uint32_t>(stations.size()));
+    writer.put(static_cast<std::uint32_t>(tags.size()));
+    writer.put(static_cast<std::uint32_t>(countries.size()));
+    writer.put(static_cast<std::uint32_t>(codecs.size()));
+    writer.put(static_cast<std::uint32_t>(posting_count));
+    const size_t pool_size_pos = writer.size();
+    writer.put(std::uint32_t{0}); // Patched once the pool is complete
+
+    for (std::uint32_t id = 0; id < stations.size(); ++id) {
+        const auto& station = stations[id];
+        writer.putStringRef(station.stationuuid, pool);
+        writer.putStringRef(station.name, pool);
+        writer.putStringRef(station.urls.empty() ? std::string() : station.urls.front(), pool);
+        writer.putStringRef(station.country_code, pool);
+        writer.putStringRef(station.format, pool);
+        writer.putStringRef(joined_tags[id], pool);
+        writer.put(static_cast<std::uint32_t>(std::max(0, station.bitrate)));
+        writer.put(static_cast<std::int32_t>(station.votes));
+    }
+    std::uint64_t total_weight = 0;
+    for (const auto& station : stations) {
+        total_weight += static_cast<std::uint64_t>(std::max(0, station.votes)) + 1;
+        writer.put(total_weight);
+    }
+    std::vector<std::uint32_t> by_bitrate(stations.size());
+    for (std::uint32_t id = 0; id < stations.size(); ++id) {
+        by_bitrate[id] = id;
+    }
+    std::stable_sort(by_bitrate.begin(), by_bitrate.end(),
+                     [&](std::uint32_t a, std::uint32_t b) { return stations[a].bitrate > stations[b].bitrate; });
+    for (std::uint32_t id : by_bitrate) {
+        writer.put(id);
+    }
+    std::uint32_t next_posting = 0;
+    for (const PostingMap* keys : {&tags, &countries, &codecs}) {
+        for (const auto& [key, ids] : *keys) {
+            writer.putStringRef(key, pool);
+            writer.put(next_posting);
+            next_posting += static_cast<std::uint32_t>(ids.size());
+            writer.put(next_posting);
+        }
+    }
+    for (const PostingMap* keys : {&tags, &countries, &codecs}) {
+        for (const auto& [key, ids] : *keys) {
+            for (std::uint32_t id : ids) {
+                writer.put(id);
+            }
+        }
+    }
+
+    writer.patch(pool_size_pos, static_cast<std::uint32_t>(pool.size()));
+    writer.putBytes(pool.data(), pool.size());
+    return writer.take();
+}
+
+bool StationCatalog::open(const std::string& filename) {
+    m_sections = Sections{};
+    if (!m_file.open(filename, HEADER_SIZE)) {
+        return false;
+    }
+
+    char magic[sizeof(CATALOG_MAGIC)];
+    BinaryReader header(m_file.data(), 0);
+    header.getBytes(magic, sizeof(magic));
+    std::uint32_t version = 0;
+    std::uint32_t strings_size = 0;
+    Sections s;
+    header.get(version);
+    header.get(s.newest_change);
+    header.get(s.station_count);
+    header.get(s.tag_count);
+    header.get(s.country_count);
+    header.get(s.codec_count);
+    header.get(s.posting_count);
+    header.get(strings_size);
+
+    if (std::memcmp(magic, CATALOG_MAGIC, sizeof(magic)) != 0 || version != CATALOG_VERSION) {
+        m_file.close();
+        return false;
+    }
+
+    s.stations = HEADER_SIZE;
+    s.weights = s.stations + size_t{s.station_count} * STATION_SIZE;
+    s.by_bitrate = s.weights + size_t{s.station_count} * sizeof(std::uint64_t);
+    s.tags = s.by_bitrate + size_t{s.station_count} * sizeof(std::uint32_t);
+    s.countries = s.tags + size_t{s.tag_count} * KEY_SIZE;
+    s.codecs = s.countries + size_t{s.country_count} * KEY_SIZE;
+    s.postings = s.codecs + size_t{s.codec_count} * KEY_SIZE;
+    s.strings = s.postings + size_t{s.posting_count} * sizeof(std::uint32_t);
+    s.strings_size = strings_size;
+    if (s.strings + s.strings_size != m_file.size()) {
+        m_file.close();
+        return false;
+    }
+    m_file.setStringPool(s.strings, s.strings_size);
+    m_sections = s;
+    return true;
+}
+
+size_t StationCatalog::stationCount() const { return m_sections.station_count; }
+
+std::time_t StationCatalog::newestChange() const { return static_cast<std::time_t>(m_sections.newest_change); }
+
+CuratorStation StationCatalog::station(std::uint32_t id) const {
+    CuratorStation station;
+    if (!m_file.isOpen() || id >= m_sections.station_count)
+        return station;
+    const size_t record = m_sections.stations + size_t{id} * STATION_SIZE;
+    station.stationuuid = std::string(m_file.stringAt(record));
+    station.name = std::string(m_file.stringAt(record + STRING_REF_SIZE));
+    station.urls.emplace_back(m_file.stringAt(record + 2 * STRING_REF_SIZE));
+    station.country_code = std::string(m_file.stringAt(record + 3 * STRING_REF_SIZE));
+    station.format = std::string(m_file.stringAt(record + 4 * STRING_REF_SIZE));
+    std::string_view tags = m_file.stringAt(record + 5 * STRING_REF_SIZE);
+    while (!tags.empty()) {
+        auto comma = tags.find(',');
+        station.tags.emplace_back(tags.substr(0, comma));
+        tags = comma == std::string_view::npos ? std::string_view() : tags.substr(comma + 1);
+    }
+    station.bitrate = static_cast<int>(m_file.read<std::uint32_t>(record + 6 * STRING_REF_SIZE));
+    station.votes = m_file.read<std::int32_t>(record + 6 * STRING_REF_SIZE + 4);
+    return station;
+}
+
+std::uint32_t StationCatalog::bitrate(std::uint32_t id) const {
+    return m_file.read<std::uint32_t>(m_sections.stations + size_t{id} * STATION_SIZE + 6 * STRING_REF_SIZE);
+}
+
+bool StationCatalog::lookup(size_t keys, std::uint32_t key_count, const std::string& key, PostingRange& range) const {
+    auto key_at = [&](std::uint32_t i) { return m_file.stringAt(keys + size_t{i} * KEY_SIZE); };
+    std::uint32_t low = 0;
+    std::uint32_t high = key_count;
+    while (low < high) {
+        std::uint32_t mid = low + (high - low) / 2;
+        if (key_at(mid) < key) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    if (low == key_count || key_at(low) != key)
+        return false;
+    const size_t record = keys + size_t{low} * KEY_SIZE;
+    range.begin = m_file.read<std::uint32_t>(record + 8);
+    range.end = m_file.read<std::uint32_t>(record + 12);
+    return range.begin <= range.end && range.end <= m_sections.posting_count;
+}
+
+bool StationCatalog::rangeContains(const PostingRange& range, std::uint32_t id) const {
+    auto id_at = [this](std::uint32_t p) {
+        return m_file.read<std::uint32_t>(m_sections.postings + size_t{p} * sizeof(std::uint32_t));
+    };
+    std::uint32_t low = range.begin;
+    std::uint32_t high = range.end;
+    while (low < high) {
+        std::uint32_t mid = low + (high - low) / 2;
+        if (id_at(mid) < id) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low < range.end && id_at(low) == id;
+}
+
+bool StationCatalog::hasTag(const std::string& tag) const {
+    PostingRange range;
+    return m_file.isOpen() && lookup(m_sections.tags, m_sections.tag_count, normalize_tag(tag), range);
+}
+
+std::vector<std::uint32_t> StationCatalog::find(const CatalogFilter& filter, size_t offset, size_t limit) const {
+    std::vector<std::uint32_t> ids;
+    if (!m_file.isOpen() || limit == 0)
+        return ids;
+
+    // Each keyed filter narrows to a posting range; the shortest one drives the scan.
+    std::vector<PostingRange> ranges;
+    const std::pair<size_t, std::uint32_t> key_sections[] = {{m_sections.tags, m_sections.tag_count},
+                                                             {m_sections.countries, m_sections.country_count},
+                                                             {m_sections.codecs, m_sections.codec_count}};
+    const std::string keys[] = {normalize_tag(filter.tag), filter.country_code, filter.codec};
+    for (size_t i = 0; i < 3; ++i) {
+        if (keys[i].empty())
+            continue;
+        PostingRange range;
+        if (!lookup(key_sections[i].first, key_sections[i].second, keys[i], range))
+            return ids;
+        ranges.push_back(range);
+    }
+    auto shortest = std::min_element(ranges.begin(), ranges.end(), [](const PostingRange& a, const PostingRange& b) {
+        return a.end - a.begin < b.end - b.begin;
+    });
+
+    size_t skipped = 0;
+    auto consider = [&](std::uint32_t id) {
+        if (id >= m_sections.station_count)
+            return true;
+        for (auto it = ranges.begin(); it != ranges.end(); ++it) {
+            if (it != shortest && !rangeContains(*it, id))
+                return true;
+        }
+        if (filter.min_bitrate > 0 && bitrate(id) < static_cast<std::uint32_t>(filter.min_bitrate))
+            return true;
+        if (skipped < offset) {
+            ++skipped;
+            return true;
+        }
+        ids.push_back(id);
+        return ids.size() < limit;
+    };
+
+    if (shortest != ranges.end()) {
+        for (std::uint32_t p = shortest->begin; p < shortest->end; ++p) {
+            if (!consider(m_file.read<std::uint32_t>(m_sections.postings + size_t{p} * sizeof(std::uint32_t))))
+                break;
+        }
+    } else if (filter.min_bitrate > 0) {
+        // Only a bitrate floor: the bitrate index gives the matches, re-sorted into votes order.
+        std::vector<std::uint32_t> matching;
+        for (std::uint32_t i = 0; i < m_sections.station_count; ++i) {
+            auto id = m_file.read<std::uint32_t>(m_sections.by_bitrate + size_t{i} * sizeof(std::uint32_t));
+            if (id >= m_sections.station_count || bitrate(id) < static_cast<std::uint32_t>(filter.min_bitrate))
+                break;
+            matching.push_back(id);
+        }
+        std::sort(matching.begin(), matching.end());
+        for (std::uint32_t id : matching) {
+            if (!consider(id))
+                break;
+        }
+    } else {
+        for (std::uint32_t id = 0; id < m_sections.station_count; ++id) {
+            if (!consider(id))
+                break;
+        }
+    }
+    return ids;
+}
+
+std::vector<std::uint32_t> StationCatalog::sample(size_t count, std::mt19937& rng) const {
+    std::vector<std::uint32_t> ids;
+    if (!m_file.isOpen() || m_sections.station_count == 0)
+        return ids;
+    auto weight_at = [this](std::uint32_t id) {
+        return m_file.read<std::uint64_t>(m_sections.weights + size_t{id} * sizeof(std::uint64_t));
+    };
+    const std::uint64_t total = weight_at(m_sections.station_count - 1);
+    if (total == 0)
+        return ids; // A corrupt catalog; there is nothing to draw from
+    std::uniform_int_distribution<std::uint64_t> draw(0, total - 1);
+
+    count = std::min<size_t>(count, m_sections.station_count);
+    std::unordered_set<std::uint32_t> picked;
+    for (size_t attempt = 0; ids.size() < count && attempt < count * SAMPLE_ATTEMPTS_PER_STATION; ++attempt) {
+        // The first station whose running total passes the draw owns it.
+        const std::uint64_t target = draw(rng);
+        std::uint32_t low = 0;
+        std::uint32_t high = m_sections.station_count - 1;
+        while (low < high) {
+            std::uint32_t mid = low + (high - low) / 2;
+            if (weight_at(mid) <= target) {
+                low = mid + 1;
+            } else {
+                high = mid;
+            }
+        }
+        if (picked.insert(low).second) {
+            ids.push_back(low);
+        }
+    }
+    return ids;
+}
@@ -0,0 +1,197 @@
+#include "Core/StationHealthProber.h"
+
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <exception>
+#include <iterator>
+
+#include "Core/Metrics.h"
+#include "Net/StreamProbe.h"
+
+namespace {
+    constexpr const char* PROBE_ENV_VAR = "STREAM_HOPPER_HEALTH_PROBE";
+    constexpr const char* RECHECK_ENV_VAR = "STREAM_HOPPER_HEALTH_RECHECK_HOURS";
+    constexpr int DEFAULT_RECHECK_HOURS = 12;
+    constexpr std::chrono::minutes FAILED_RECHECK_INTERVAL(10);
+    constexpr std::chrono::milliseconds PROBE_TIMEOUT(8000);
+    constexpr std::chrono::seconds PROBE_SPACING(2);
+    constexpr std::chrono::seconds SAVE_INTERVAL(60);
+    constexpr std::chrono::hours FORGET_AFTER(24 * 30); // Results for URLs not seen since are dropped
+    constexpr int LOWEST_PRIORITY = 19;
+
+    constexpr double RELIABILITY_WEIGHT = 0.3; // Of the newest probe in the moving average
+    constexpr double UNPROBED_SCORE = 0.5;
+    constexpr int DEAD_AFTER_FAILURES = 2;
+
+    bool probing_enabled() {
+        const char* value = getenv(PROBE_ENV_VAR);
+        return !value || std::strcmp(value, "0") != 0;
+    }
+
+    std::chrono::seconds recheck_interval_from_environment() {
+        int hours = DEFAULT_RECHECK_HOURS;
+        if (const char* value = getenv(RECHECK_ENV_VAR)) {
+            hours = std::max(std::atoi(value), 1);
+        }
+        return std::chrono::hours(hours);
+    }
+} // namespace
+
+StationHealthProber::StationHealthProber()
+    : m_enabled(probing_enabled()), m_recheck_interval(recheck_interval_from_environment()) {}
+
+StationHealthProber::~StationHealthProber() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_cond.notify_one();
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+void StationHealthProber::start() {
+    if (m_enabled && !m_thread.joinable()) {
+        m_thread = std::thread(&StationHealthProber::run, this);
+    }
+}
+
+void StationHealthProber::setUrls(std::vector<std::string> urls) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_urls = std::move(urls);
+    }
+    m_cond.notify_one();
+}
+
+std::map<std::string, UrlHealth> StationHealthProber::results() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_health;
+}
+
+double StationHealthProber::score(const UrlHealth& health) {
+    if (health.last_checked == 0) {
+        return UNPROBED_SCORE;
+    }
+    // A stream that answers in a second keeps 75% of its reliability; slower ones less.
+    double speed = 1.0 / (1.0 + health.time_to_first_byte_ms / 1000.0);
+    return health.reliability * (0.5 + 0.5 * speed);
+}
+
+bool StationHealthProber::isDead(const UrlHealth& health) {
+    return health.consecutive_failures >= DEAD_AFTER_FAILURES;
+}
+
+void StationHealthProber::run() {
+    // On Linux this only lowers the calling thread, not the player.
+    setpriority(PRIO_PROCESS, 0, LOWEST_PRIORITY);
+    auto loaded = PersistenceManager().loadStationHealth();
+
+    StreamProbe probe;
+    std::unique_lock<std::mutex> lock(m_mutex);
+    for (auto& [url, health] : loaded) {
+        m_health.emplace(url, health); // Anything probed meanwhile is newer
+    }
+    m_last_save = std::chrono::steady_clock::now();
+    ++m_version;
+
+    while (!m_stop) {
+        std::string url;
+        auto due = std::chrono::system_clock::time_point::max();
+        if (!nextDue(url, due) || due > std::chrono::system_clock::now()) {
+            // Woken early by new URLs or by stopping.
+            auto wait = std::min<std::chrono::system_clock::duration>(due - std::chrono::system_clock::now(),
+                                                                       std::chrono::minutes(1));
+            m_cond.wait_for(lock, wait);
+            continue;
+        }
+
+        lock.unlock();
+        StreamProbeResult result;
+        try {
+            result = probe.probe(url, PROBE_TIMEOUT);
+        } catch (const std::exception& e) {
+            result.error = e.what();
+        }
+        lock.lock();
+
+        record(url, result.reachable, static_cast<int>(result.time_to_first_byte.count()), result.codec,
+               result.bitrate);
+        saveIfDirty(lock, false);
+        m_cond.wait_for(lock, PROBE_SPACING, [this] { return m_stop; });
+    }
+    saveIfDirty(lock, true);
+}
+
+bool StationHealthProber::nextDue(std::string& url, std::chrono::system_clock::time_point& due) const {
+    bool found = false;
+    for (const auto& candidate : m_urls) {
+        auto it = m_health.find(candidate);
+        auto candidate_due = std::chrono::system_clock::time_point::min(); // Never probed
+        if (it != m_health.end() && it->second.last_checked != 0) {
+            auto interval = it->second.consecutive_failures > 0
+                                ? std::chrono::duration_cast<std::chrono::seconds>(FAILED_RECHECK_INTERVAL)
+                                : m_recheck_interval;
+            candidate_due = std::chrono::system_clock::from_time_t(it->second.last_checked) + interval;
+        }
+        if (!found || candidate_due < due) { // Ties go to the earlier, more urgent URL
+            url = candidate;
+            due = candidate_due;
+            found = true;
+        }
+    }
+    return found;
+}
+
+void StationHealthProber::record(
+    const std::string& url, bool reachable, int ttfb_ms, const std::string& codec, int bitrate) {
+    UrlHealth& health = m_health[url];
+    double outcome = reachable ? 1.0 : 0.0;
+    health.reliability = health.last_checked == 0
+                             ? outcome
+                             : (1.0 - RELIABILITY_WEIGHT) * health.reliability + RELIABILITY_WEIGHT * outcome;
+    health.last_checked = std::time(nullptr);
+    if (reachable) {
+        health.time_to_first_byte_ms = ttfb_ms;
+        if (!codec.empty())
+            health.codec = codec;
+        if (bitrate > 0)
+            health.bitrate = bitrate;
+        health.consecutive_failures = 0;
+        Metrics::recordDuration("health.time_to_first_byte", std::chrono::milliseconds(ttfb_ms));
+    } else {
+        ++health.consecutive_failures;
+        Metrics::increment("health.probe_failures");
+    }
+    Metrics::increment("health.probes");
+    m_dirty = true;
+    ++m_version;
+}
+
+// Writes are batched to one a minute; the file is rewritten whole.
+void StationHealthProber::saveIfDirty(std::unique_lock<std::mutex>& lock, bool force) {
+    auto now = std::chrono::steady_clock::now();
+    if (!m_dirty || (!force && now - m_last_save < SAVE_INTERVAL)) {
+        return;
+    }
+    const std::time_t cutoff =
+        std::time(nullptr) - std::chrono::duration_cast<std::chrono::seconds>(FORGET_AFTER).count();
+    for (auto it = m_health.begin(); it != m_health.end();) {
+        it = it->second.last_checked < cutoff ? m_health.erase(it) : std::next(it);
+    }
+    auto snapshot = m_health;
+    m_dirty = false;
+    m_last_save = now;
+    lock.unlock();
+    try {
+        PersistenceManager().saveStationHealth(snapshot);
+    } catch (const std::exception&) {
+        Metrics::increment("persist.failed.station_health");
+    }
+    lock.lock();
+}
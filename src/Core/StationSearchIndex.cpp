@@ -0,0 +1,160 @@
+#include "Core/StationSearchIndex.h"
+
+#include <algorithm>
+#include <cctype>
+#include <utility>
+
+namespace {
+    // Scoring bonuses on top of the trigram overlap ratio (0..1).
+    constexpr double NAME_WORD_MATCH_BONUS = 2.0; // Query starts at a word in the name
+    constexpr double NAME_SUBSTRING_BONUS = 1.0;  // Query appears anywhere in the name
+    constexpr double TAG_WORD_MATCH_BONUS = 0.5;  // Query starts at a word in the tags
+
+    std::uint32_t trigram_key(const std::string& text, size_t pos) {
+        return (static_cast<std::uint32_t>(static_cast<unsigned char>(text[pos])) << 16) |
+               (static_cast<std::uint32_t>(static_cast<unsigned char>(text[pos + 1])) << 8) |
+               static_cast<std::uint32_t>(static_cast<unsigned char>(text[pos + 2]));
+    }
+}
+
+// Lowercases ASCII, turns ASCII punctuation into word breaks and pads the
+// result with spaces so that word starts and ends form their own trigrams.
+// Non-ASCII bytes (UTF-8) are kept as they are.
+std::string StationSearchIndex::normalize(const std::string& text) {
+    std::string out = " ";
+    out.reserve(text.size() + 2);
+    for (char c : text) {
+        auto uc = static_cast<unsigned char>(c);
+        if (uc >= 0x80 || std::isalnum(uc)) {
+            out.push_back(static_cast<char>(std::tolower(uc)));
+        } else if (out.back() != ' ') {
+            out.push_back(' ');
+        }
+    }
+    if (out.back() != ' ') {
+        out.push_back(' ');
+    }
+    return out;
+}
+
+void StationSearchIndex::clear() {
+    m_documents.clear();
+    m_postings.clear();
+    m_indexed_count = 0;
+}
+
+void StationSearchIndex::add(int station_id, const std::string& name, const std::vector<std::string>& tags) {
+    std::string joined_tags;
+    for (const auto& tag : tags) {
+        joined_tags += tag;
+        joined_tags += ' ';
+    }
+    m_documents.push_back({station_id, normalize(name), normalize(joined_tags)});
+}
+
+void StationSearchIndex::dropFront(size_t count) {
+    count = std::min(count, m_documents.size());
+    m_documents.erase(m_documents.begin(), m_documents.begin() + count);
+    for (auto& doc : m_documents) {
+        doc.station_id -= static_cast<int>(count);
+    }
+    // Postings hold document positions, so they are rebuilt by the next search.
+    m_postings.clear();
+    m_indexed_count = 0;
+}
+
+void StationSearchIndex::indexPendingDocuments() {
+    for (; m_indexed_count < m_documents.size(); ++m_indexed_count) {
+        const auto doc_pos = static_cast<std::uint32_t>(m_indexed_count);
+        const Document& doc = m_documents[m_indexed_count];
+        for (const std::string* text : {&doc.name, &doc.tags}) {
+            for (size_t i = 0; i + 3 <= text->size(); ++i) {
+                auto& posting = m_postings[trigram_key(*text, i)];
+                if (posting.empty() || posting.back() != doc_pos) {
+                    posting.push_back(doc_pos);
+                }
+            }
+        }
+    }
+}
+
+double StationSearchIndex::score(const Document& doc, const std::string& query, const std::string& padded_query) const {
+    if (doc.name.find(padded_query) != std::string::npos)
+        return NAME_WORD_MATCH_BONUS;
+    if (doc.name.find(query) != std::string::npos)
+        return NAME_SUBSTRING_BONUS;
+    if (doc.tags.find(padded_query) != std::string::npos)
+        return TAG_WORD_MATCH_BONUS;
+    return 0.0;
+}
+
+std::vector<int> StationSearchIndex::search(const std::string& query, size_t max_results) {
+    std::vector<int> results;
+    std::string padded_query = normalize(query);
+    if (padded_query.size() <= 1 || max_results == 0) {
+        return results;
+    }
+    // The user is still typing, so the last word must not be forced to end here.
+    padded_query.pop_back();
+    const std::string bare_query = padded_query.substr(1);
+
+    indexPendingDocuments();
+
+    std::vector<std::uint32_t> query_trigrams;
+    for (size_t i = 0; i + 3 <= padded_query.size(); ++i) {
+        query_trigrams.push_back(trigram_key(padded_query, i));
+    }
+    std::sort(query_trigrams.begin(), query_trigrams.end());
+    query_trigrams.erase(std::unique(query_trigrams.begin(), query_trigrams.end()), query_trigrams.end());
+
+    std::vector<std::pair<double, std::uint32_t>> ranked;
+    if (query_trigrams.empty()) {
+        // A single character has no trigram; match it against word starts directly.
+        for (std::uint32_t d = 0; d < m_documents.size(); ++d) {
+            double s = score(m_documents[d], bare_query, padded_query);
+            if (s >= TAG_WORD_MATCH_BONUS) {
+                ranked.emplace_back(s, d);
+            }
+        }
+    } else {
+        std::vector<std::uint16_t> shared(m_documents.size(), 0);
+        std::vector<std::uint32_t> touched;
+        for (std::uint32_t trigram : query_trigrams) {
+            auto it = m_postings.find(trigram);
+            if (it == m_postings.end())
+                continue;
+            for (std::uint32_t d : it->second) {
+                if (shared[d]++ == 0) {
+                    touched.push_back(d);
+                }
+            }
+        }
+        // Tolerate roughly one typo in three trigrams.
+        const size_t total = query_trigrams.size();
+        const size_t needed = std::max<size_t>(1, total - total / 3);
+        for (std::uint32_t d : touched) {
+            if (shared[d] >= needed) {
+                double overlap = static_cast<double>(shared[d]) / static_cast<double>(total);
+                ranked.emplace_back(overlap + score(m_documents[d], bare_query, padded_query), d);
+            }
+        }
+    }
+
+    auto better = [this](const auto& a, const auto& b) {
+        if (a.first != b.first)
+            return a.first > b.first;
+        const Document& da = m_documents[a.second];
+        const Document& db = m_documents[b.second];
+        if (da.name.size() != db.name.size())
+            return da.name.size() < db.name.size(); // Prefer the closer (shorter) name
+        return da.station_id < db.station_id;
+    };
+    size_t count = std::min(max_results, ranked.size());
+    std::partial_sort(ranked.begin(), ranked.begin() + count, ranked.end(), better);
+
+    results.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        results.push_back(m_documents[ranked[i].second].station_id);
+    }
+    return results;
+}
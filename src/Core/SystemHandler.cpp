@@ -31,6 +31,14 @@ void SystemHandler::process_system(StationManager& manager, const StationManager
 
 void SystemHandler::handle_saveVolumeOffsets(StationManager& manager) { manager.saveVolumeOffsetsToDisk(); }
 
+void SystemHandler::check_navigation_settled(StationManager& manager) {
+    const auto& deadline = manager.m_session_state.window_commit_deadline;
+    if (deadline && std::chrono::steady_clock::now() >= *deadline) {
+        manager.updateActiveWindow();
+        manager.requestRedraw();
+    }
+}
+
 void SystemHandler::check_copy_mode_timeout(StationManager& manager) {
     if (manager.m_session_state.copy_mode_active) {
         auto now = std::chrono::steady_clock::now();
@@ -63,7 +71,7 @@ void SystemHandler::check_focus_mode_timer(StationManager& manager) {
             FOCUS_MODE_SECONDS) {
             manager.m_session_state.hopper_mode = HopperMode::FOCUS;
             manager.updateActiveWindow();
-            manager.m_needs_redraw = true;
+            manager.requestRedraw();
         }
     }
 }
@@ -88,18 +96,33 @@ void SystemHandler::handle_updateAndPoll(StationManager& manager) {
     manager.m_update_manager->process_updates(manager);
     manager.pollMpvEvents();
 
+    check_navigation_settled(manager);
     check_copy_mode_timeout(manager);
     check_auto_hop_timer(manager);
     check_focus_mode_timer(manager);
     check_mute_timeout(manager);
 
-    bool is_any_station_cycling =
-        std::any_of(manager.m_stations.begin(), manager.m_stations.end(),
-                    [](const RadioStream& s) { return s.getCyclingState() == CyclingState::CYCLING; });
+    if (manager.m_session_state.auto_hop_mode_active) {
+        long elapsed_s = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::steady_clock::now() -
+                                                                          manager.m_session_state.auto_hop_start_time)
+                             .count();
+        if (elapsed_s != manager.m_session_state.auto_hop_drawn_elapsed_s) {
+            manager.m_session_state.auto_hop_drawn_elapsed_s = elapsed_s;
+            manager.requestRedraw();
+        }
+    }
 
-    if (manager.m_session_state.auto_hop_mode_active || is_any_station_cycling) {
-        manager.m_needs_redraw = true;
+    // Only initialized stations can be cycling; keep their spinner turning.
+    bool is_any_station_cycling =
+        std::any_of(manager.m_active_station_indices.begin(), manager.m_active_station_indices.end(), [&](int idx) {
+            return manager.m_stations[idx].getCyclingState() == CyclingState::CYCLING;
+        });
+    if (is_any_station_cycling && manager.m_animations_enabled) {
+        manager.requestRedraw();
     }
 }
 
-void SystemHandler::handle_quit(StationManager& manager) { manager.m_quit_flag = true; }
+void SystemHandler::handle_quit(StationManager& manager) {
+    manager.m_quit_flag = true;
+    manager.m_ui_wakeup.notify(); // The UI may be asleep in poll()
+}
@@ -3,91 +3,141 @@
 #include <algorithm> // For std::any_of, std::remove_if
 #include <chrono>
 
+#include "Core/Metrics.h"
+#include "Core/RandomStationQueue.h"
+#include "Core/ReconnectScheduler.h"
+#include "Core/StationHealthProber.h"
 #include "Core/VolumeNormalizer.h"
-#include "PersistenceManager.h" // For StationData
 #include "RadioStream.h"
 #include "StationManager.h"
+#include "Utils.h" // For check_mpv_error
 
 namespace {
     // Constants related to update logic
     constexpr int CYCLE_TIMEOUT_SECONDS = 8;
-    constexpr int RANDOM_STATIONS_TARGET_COUNT = 15;
+    // How long the rest of the preload window waits for the first station's audio.
+    constexpr auto STARTUP_PRELOAD_GRACE = std::chrono::milliseconds(1500);
 }
 
 void UpdateManager::process_updates(StationManager& manager) {
+    handle_startup_pipeline(manager);
     handle_random_station_fetch(manager);
+    handle_station_health(manager);
     handle_temporary_message_timer(manager);
     handle_cycle_status_timers(manager);
     handle_cycle_timeouts(manager);
+    handle_reconnects(manager);
     handle_activeFades(manager);
     handle_volume_normalizer_timeout(manager);
-    if (manager.m_is_fetching_random_stations) {
-        manager.m_needs_redraw = true; // Keep UI animating while spinner is active
+    handle_loudness_measurement(manager);
+    if (manager.m_is_fetching_random_stations && manager.m_animations_enabled) {
+        manager.requestRedraw(); // Keep UI animating while spinner is active
     }
 }
 
-void UpdateManager::handle_random_station_fetch(StationManager& manager) {
-    if (!manager.m_is_fetching_random_stations || !manager.m_random_stations_future.valid()) {
+void UpdateManager::handle_startup_pipeline(StationManager& manager) {
+    if (!manager.m_startup_data_applied && manager.isStartupDataReady()) {
+        manager.applyStartupData();
+    }
+    if (manager.m_startup_window_filled) {
         return;
     }
+    // Hold back the other preloads until the active station is audible, so they
+    // do not compete with it for bandwidth and CPU while it connects.
+    auto waited = std::chrono::steady_clock::now() - manager.m_startup_stage_start;
+    if (manager.m_first_audio_recorded || waited >= STARTUP_PRELOAD_GRACE) {
+        manager.m_startup_window_filled = true;
+        manager.updateActiveWindow();
+        manager.m_health_prober->start();
+    }
+}
 
-    // Check if the future is ready without blocking
-    if (manager.m_random_stations_future.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
-        auto fetched_stations = manager.m_random_stations_future.get();
+// Random mode ran ahead of the queue; fill the list as soon as it has stations.
+void UpdateManager::handle_random_station_fetch(StationManager& manager) {
+    if (!manager.m_is_fetching_random_stations) {
+        return;
+    }
+    if (manager.takeRandomStations(manager.m_fetch_is_for_append)) {
         manager.m_is_fetching_random_stations = false;
+    } else if (manager.m_random_station_queue->lastFetchFailed()) {
+        manager.m_is_fetching_random_stations = false;
+        manager.m_session_state.temporary_status_message = "[Error] Failed to fetch stations.";
+        manager.m_session_state.temporary_message_end_time = std::chrono::steady_clock::now() + std::chrono::seconds(3);
+        manager.requestRedraw();
+    }
+}
 
-        if (fetched_stations.empty()) {
-            manager.m_session_state.temporary_status_message = "[Error] Failed to fetch stations.";
-            manager.m_session_state.temporary_message_end_time =
-                std::chrono::steady_clock::now() + std::chrono::seconds(3);
-        } else {
-            StationData new_station_data;
-            for (const auto& s : fetched_stations) {
-                if (manager.m_seen_random_station_uuids.find(s.stationuuid) ==
-                    manager.m_seen_random_station_uuids.end()) {
-                    new_station_data.push_back({s.name, s.urls});
-                    manager.m_seen_random_station_uuids.insert(s.stationuuid);
-                    if (new_station_data.size() >= RANDOM_STATIONS_TARGET_COUNT) {
-                        break;
-                    }
-                }
-            }
+// New probe results: put each idle station's healthiest URL first and mark the
+// stations that have no live URL left. Loaded stations keep their URLs.
+void UpdateManager::handle_station_health(StationManager& manager) {
+    unsigned long version = manager.m_health_prober->version();
+    if (version == manager.m_applied_health_version) {
+        return;
+    }
+    manager.m_applied_health_version = version;
+    const auto results = manager.m_health_prober->results();
+    const UrlHealth unprobed;
+    auto health_of = [&](const std::string& url) -> const UrlHealth& {
+        auto it = results.find(url);
+        return it != results.end() ? it->second : unprobed;
+    };
 
-            if (manager.m_fetch_is_for_append) {
-                if (!new_station_data.empty()) {
-                    manager.appendStations(new_station_data);
-                }
-            } else {
-                manager.resetWithNewStations(new_station_data);
-            }
+    bool changed = false;
+    for (RadioStream& station : manager.m_stations) {
+        if (station.isInitialized() || station.getCyclingState() != CyclingState::IDLE) {
+            continue;
+        }
+        std::vector<std::string> urls = station.getAllUrls();
+        std::stable_sort(urls.begin(), urls.end(), [&](const std::string& a, const std::string& b) {
+            return StationHealthProber::score(health_of(a)) > StationHealthProber::score(health_of(b));
+        });
+        bool unreachable = !urls.empty() && std::all_of(urls.begin(), urls.end(), [&](const std::string& url) {
+            return StationHealthProber::isDead(health_of(url));
+        });
+        if (urls != station.getAllUrls()) {
+            station.setUrlOrder(std::move(urls));
+            Metrics::increment("health.stations_reordered");
         }
-        manager.m_needs_redraw = true;
+        if (unreachable != station.isUnreachable()) {
+            station.setUnreachable(unreachable);
+            changed = true;
+        }
+    }
+    if (changed) {
+        manager.requestRedraw();
     }
 }
 
 void UpdateManager::handle_volume_normalizer_timeout(StationManager& manager) {
     if (manager.m_volume_normalizer->checkTimeout()) {
         manager.post(Msg::SaveVolumeOffsets{});
-        manager.m_needs_redraw = true;
+        manager.requestRedraw();
     }
 }
 
+void UpdateManager::handle_loudness_measurement(StationManager& manager) {
+    manager.m_volume_normalizer->measureLoudness(manager);
+}
+
 void UpdateManager::handle_temporary_message_timer(StationManager& manager) {
     if (auto end_time = manager.m_session_state.temporary_message_end_time) {
         if (std::chrono::steady_clock::now() >= *end_time) {
             manager.m_session_state.temporary_status_message.clear();
             manager.m_session_state.temporary_message_end_time = std::nullopt;
-            manager.m_needs_redraw = true;
+            manager.requestRedraw();
         }
     }
 }
 
+// Cycling state only lives on initialized stations (shutdown resets it), so
+// these timers only need to look at the active window, not the whole list.
 void UpdateManager::handle_cycle_status_timers(StationManager& manager) {
-    for (auto& station : manager.m_stations) {
+    for (int idx : manager.m_active_station_indices) {
+        RadioStream& station = manager.m_stations[idx];
         if (station.getCyclingState() == CyclingState::SUCCEEDED || station.getCyclingState() == CyclingState::FAILED) {
             if (std::chrono::steady_clock::now() >= station.getCycleStatusEndTime()) {
                 station.clearCycleStatus();
-                manager.m_needs_redraw = true;
+                manager.requestRedraw();
             }
         }
     }
@@ -95,24 +145,46 @@ void UpdateManager::handle_cycle_status_timers(StationManager& manager) {
 
 void UpdateManager::handle_cycle_timeouts(StationManager& manager) {
     auto now = std::chrono::steady_clock::now();
-    for (auto& station : manager.m_stations) {
+    for (int idx : manager.m_active_station_indices) {
+        RadioStream& station = manager.m_stations[idx];
+        if (auto race_start = station.getRaceStartTime()) {
+            if (now - *race_start >= std::chrono::seconds(CYCLE_TIMEOUT_SECONDS)) {
+                station.endRace();
+            }
+        }
         if (station.getCyclingState() == CyclingState::CYCLING) {
             if (auto start_time = station.getCycleStartTime()) {
                 if (std::chrono::duration_cast<std::chrono::seconds>(now - *start_time).count() >=
                     CYCLE_TIMEOUT_SECONDS) {
                     station.finalizeCycle(false);
-                    manager.m_needs_redraw = true;
+                    manager.requestRedraw();
                 }
             }
         }
     }
 }
 
+void UpdateManager::handle_reconnects(StationManager& manager) {
+    for (int idx : manager.m_reconnect_scheduler->takeDue(std::chrono::steady_clock::now())) {
+        RadioStream& station = manager.m_stations[idx];
+        if (!station.isInitialized()) {
+            manager.m_reconnect_scheduler->forget(idx);
+            continue;
+        }
+        int tries = manager.m_reconnect_scheduler->status(idx).consecutive_failures;
+        station.setCurrentTitle("Stream Error - Reconnecting (try " + std::to_string(tries + 1) + ")...");
+        const char* cmd[] = {"loadfile", station.getActiveUrl().c_str(), "replace", nullptr};
+        check_mpv_error(mpv_command_async(station.getMpvHandle(), 0, cmd), "reconnect on eof");
+        manager.requestRedraw();
+    }
+}
+
 void UpdateManager::handle_activeFades(StationManager& manager) {
     if (manager.m_active_fades.empty())
         return;
     auto now = std::chrono::steady_clock::now();
     bool changed = false;
+    bool finished = false;
 
     manager.m_active_fades.erase(
         std::remove_if(manager.m_active_fades.begin(), manager.m_active_fades.end(),
@@ -158,12 +230,14 @@ void UpdateManager::handle_activeFades(StationManager& manager) {
                                } else if (station.getCyclingState() == CyclingState::SUCCEEDED) {
                                    station.getPendingMpvInstance().shutdown();
                                }
+                               finished = true;
                                return true;
                            }
                            return false;
                        }),
         manager.m_active_fades.end());
 
-    if (changed)
-        manager.m_needs_redraw = true;
+    // Without animations only the end of a fade is shown.
+    if (finished || (changed && manager.m_animations_enabled))
+        manager.requestRedraw();
 }
@@ -1,10 +1,43 @@
 #include "Core/VolumeNormalizer.h"
 
+#include <mpv/client.h>
+
 #include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
 
+#include "Core/Metrics.h"
 #include "RadioStream.h"
 #include "StationManager.h" // To call applyCombinedVolume
 
+namespace {
+    constexpr const char* AUTO_LOUDNESS_ENV_VAR = "STREAM_HOPPER_AUTO_LOUDNESS";
+    // ebur128 tags its output frames with the running loudness; mpv exposes the tags by filter label.
+    constexpr const char* LOUDNESS_FILTER = "@loudness:lavfi=[ebur128=metadata=1]";
+    constexpr const char* LOUDNESS_FILTER_LABEL = "@loudness";
+    constexpr const char* INTEGRATED_LOUDNESS_PROPERTY = "af-metadata/loudness/by-key/lavfi.r128.I";
+
+    constexpr double SILENCE_LOUDNESS = -60.0;  // ebur128 reports -70 before any audio
+    constexpr double SETTLED_WITHIN_LU = 0.5;   // Drift that still counts as settled
+    constexpr auto SETTLE_TIME = std::chrono::seconds(10);
+    constexpr auto MIN_MEASURE_TIME = std::chrono::seconds(20);
+    constexpr auto MAX_MEASURE_TIME = std::chrono::seconds(90);
+
+    bool auto_loudness_enabled() {
+        const char* value = getenv(AUTO_LOUDNESS_ENV_VAR);
+        return value && std::strcmp(value, "1") == 0;
+    }
+
+    // mpv's volume is cubic: a change from 100 to v is 60*log10(v/100) dB.
+    double offset_for_gain(double gain_db) {
+        double volume = 100.0 * std::pow(10.0, gain_db / 60.0);
+        return std::clamp(std::round(volume - 100.0), VolumeNormalizer::MIN_OFFSET, VolumeNormalizer::MAX_OFFSET);
+    }
+} // namespace
+
+VolumeNormalizer::VolumeNormalizer() : m_auto_enabled(auto_loudness_enabled()) {}
+
 void VolumeNormalizer::adjust(StationManager& manager, RadioStream& station, double amount) {
     double current_offset = station.getVolumeOffset();
     double new_offset = std::clamp(current_offset + amount, MIN_OFFSET, MAX_OFFSET);
@@ -31,3 +64,114 @@ bool VolumeNormalizer::checkTimeout() {
 }
 
 bool VolumeNormalizer::isUiActive() const { return m_is_ui_active; }
+
+void VolumeNormalizer::measureLoudness(StationManager& manager) {
+    // Saved offsets load in the background; until then every station looks unset.
+    if (!m_auto_enabled || !manager.m_startup_data_applied) {
+        return;
+    }
+    auto now = std::chrono::steady_clock::now();
+    if (now < m_next_measure_poll) {
+        return;
+    }
+    m_next_measure_poll = now + MEASURE_POLL_INTERVAL;
+    if (!m_measurement || !continueMeasurement(manager)) {
+        startMeasurement(manager);
+    }
+}
+
+RadioStream* VolumeNormalizer::measuredStation(StationManager& manager) const {
+    for (int idx : manager.m_active_station_indices) {
+        RadioStream& station = manager.m_stations[idx];
+        if (station.getName() == m_measurement->station_name &&
+            station.getGeneration() == m_measurement->generation) {
+            return &station;
+        }
+    }
+    return nullptr;
+}
+
+// Returns false once the measurement is over.
+bool VolumeNormalizer::continueMeasurement(StationManager& manager) {
+    RadioStream* station = measuredStation(manager);
+    if (!station) {
+        m_measurement.reset(); // Unloaded, and its filter with it
+        return false;
+    }
+    if (station->getID() == manager.m_session_state.active_station_idx) {
+        // Now audible, so an offset appearing mid-song would be jarring. Removing the
+        // filter would rebuild the filter chain just as it is heard, so it stays until
+        // the station unloads. It is not picked again meanwhile, since a second filter
+        // would fail to add under the same label and its stale loudness would be read.
+        m_measured_names.insert(station->getName());
+        m_measurement.reset();
+        return false;
+    }
+    if (std::abs(station->getVolumeOffset()) > 0.01) {
+        m_measured_names.insert(station->getName()); // Set by hand meanwhile
+        stopMeasurement(station);
+        return false;
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    if (char* value = mpv_get_property_string(station->getMpvHandle(), INTEGRATED_LOUDNESS_PROPERTY)) {
+        double loudness = std::atof(value);
+        mpv_free(value);
+        if (loudness > SILENCE_LOUDNESS &&
+            (!m_measurement->loudness || std::abs(loudness - *m_measurement->loudness) > SETTLED_WITHIN_LU)) {
+            m_measurement->loudness = loudness;
+            m_measurement->loudness_since = now;
+        }
+    }
+
+    bool settled = m_measurement->loudness && now - m_measurement->started >= MIN_MEASURE_TIME &&
+                   now - m_measurement->loudness_since >= SETTLE_TIME;
+    bool out_of_time = now - m_measurement->started >= MAX_MEASURE_TIME;
+    if (!settled && !out_of_time) {
+        return true;
+    }
+
+    m_measured_names.insert(station->getName());
+    if (settled) {
+        station->setVolumeOffset(offset_for_gain(TARGET_LOUDNESS - *m_measurement->loudness));
+        manager.applyCombinedVolume(station->getID());
+        manager.saveVolumeOffsetsToDisk();
+        Metrics::increment("loudness.measured");
+    } else {
+        Metrics::increment("loudness.gave_up");
+    }
+    stopMeasurement(station);
+    return false;
+}
+
+// Picks the playing, unmeasured preload nearest the cursor, as the likeliest next listen.
+void VolumeNormalizer::startMeasurement(StationManager& manager) {
+    const int cursor = manager.m_session_state.active_station_idx;
+    RadioStream* best = nullptr;
+    for (int idx : manager.m_active_station_indices) {
+        RadioStream& station = manager.m_stations[idx];
+        if (idx == cursor || !station.isInitialized() || station.isBuffering() || station.getBitrate() <= 0 ||
+            std::abs(station.getVolumeOffset()) > 0.01 || m_measured_names.count(station.getName())) {
+            continue;
+        }
+        if (!best || std::abs(idx - cursor) < std::abs(best->getID() - cursor)) {
+            best = &station;
+        }
+    }
+    if (!best) {
+        return;
+    }
+    const char* cmd[] = {"af", "add", LOUDNESS_FILTER, nullptr};
+    if (mpv_command_async(best->getMpvHandle(), 0, cmd) < 0) {
+        m_measured_names.insert(best->getName());
+        return;
+    }
+    auto now = std::chrono::steady_clock::now();
+    m_measurement = Measurement{best->getName(), best->getGeneration(), now, std::nullopt, now};
+}
+
+void VolumeNormalizer::stopMeasurement(RadioStream* station) {
+    const char* cmd[] = {"af", "remove", LOUDNESS_FILTER_LABEL, nullptr};
+    mpv_command_async(station->getMpvHandle(), 0, cmd);
+    m_measurement.reset();
+}
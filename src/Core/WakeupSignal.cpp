@@ -0,0 +1,26 @@
+#include "Core/WakeupSignal.h"
+
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <stdexcept>
+
+WakeupSignal::WakeupSignal() : m_fd(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)) {
+    if (m_fd < 0) {
+        throw std::runtime_error("Could not create a wakeup eventfd.");
+    }
+}
+
+WakeupSignal::~WakeupSignal() { close(m_fd); }
+
+void WakeupSignal::notify() {
+    const std::uint64_t one = 1;
+    // Can only fail if the counter is about to overflow, which still leaves it readable.
+    [[maybe_unused]] ssize_t written = write(m_fd, &one, sizeof(one));
+}
+
+void WakeupSignal::drain() {
+    std::uint64_t count;
+    [[maybe_unused]] ssize_t n = read(m_fd, &count, sizeof(count)); // EAGAIN when nothing is pending
+}
@@ -2,13 +2,17 @@
 
 #include <mpv/client.h>
 #include <ncurses.h>
+#include <poll.h>
+#include <unistd.h>
 
 #include <algorithm>
 #include <cctype>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
 #include <fstream>
 #include <iomanip>
 #include <sstream>
-#include <thread>
 
 #include "CuratorUI.h"
 #include "Utils.h"
@@ -16,59 +20,149 @@
 
 using json = nlohmann::json;
 
-CuratorApp::CuratorApp(const std::string& genre, std::vector<CuratorStation> candidates)
-    : m_genre(genre), m_candidates(std::move(candidates)), m_current_index(0), m_quit_flag(false) {
-    m_ui = std::make_unique<CuratorUI>();
-    if (!m_candidates.empty()) {
-        update_preloaded_stations();
-    } else {
-        m_quit_flag = true;
+namespace {
+    constexpr const char* PRELOAD_AHEAD_ENV_VAR = "STREAM_HOPPER_CURATOR_AHEAD";
+    constexpr const char* PRELOAD_BEHIND_ENV_VAR = "STREAM_HOPPER_CURATOR_BEHIND";
+    constexpr int DEFAULT_PRELOAD_AHEAD = 2;
+    constexpr int DEFAULT_PRELOAD_BEHIND = 1;
+    constexpr int MAX_PRELOAD_DEPTH = 10;
+
+    int preload_depth_from_environment(const char* env_var, int fallback) {
+        if (const char* value = getenv(env_var)) {
+            return std::clamp(std::atoi(value), 0, MAX_PRELOAD_DEPTH);
+        }
+        return fallback;
+    }
+
+    // Called by mpv on one of its own threads whenever a handle queues an event.
+    void notify_wakeup(void* wakeup) { static_cast<WakeupSignal*>(wakeup)->notify(); }
+
+    bool is_ready(const std::future<std::unique_ptr<RadioStream>>& future) {
+        return future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
     }
 }
 
-CuratorApp::~CuratorApp() { m_station_pool.clear(); }
+CuratorApp::CuratorApp(const std::string& genre, CandidateFeed& feed)
+    : m_genre(genre), m_feed(feed), m_current_index(0), m_quit_flag(false),
+      m_preload_ahead(preload_depth_from_environment(PRELOAD_AHEAD_ENV_VAR, DEFAULT_PRELOAD_AHEAD)),
+      m_preload_behind(preload_depth_from_environment(PRELOAD_BEHIND_ENV_VAR, DEFAULT_PRELOAD_BEHIND)) {
+    m_ui = std::make_unique<CuratorUI>();
+    m_feed.setListener([this] { m_wakeup.notify(); });
+    pull_candidates();
+    update_preloaded_stations();
+}
 
-void CuratorApp::update_preloaded_stations() {
-    m_station_pool.erase(std::remove_if(m_station_pool.begin(), m_station_pool.end(),
-                                        [this](const auto& s) { return s->getID() < m_current_index; }),
-                         m_station_pool.end());
+CuratorApp::~CuratorApp() {
+    m_feed.setListener(nullptr);
+    // Waits for loads still in flight; their wakeup callbacks point at m_wakeup.
+    m_station_pool.clear();
+    m_loading.clear();
+    m_retiring.clear();
+}
 
-    for (int i = 0; i <= PRELOAD_COUNT; ++i) {
-        int target_index = m_current_index + i;
-        if (target_index >= static_cast<int>(m_candidates.size()))
-            break;
+bool CuratorApp::is_in_preload_window(int index) const {
+    return index >= m_current_index - m_preload_behind && index <= m_current_index + m_preload_ahead &&
+           index >= 0 && index < static_cast<int>(m_candidates.size());
+}
+
+void CuratorApp::update_preloaded_stations() {
+    for (auto it = m_station_pool.begin(); it != m_station_pool.end();) {
+        if (is_in_preload_window((*it)->getID())) {
+            ++it;
+        } else {
+            retire_station(std::move(*it));
+            it = m_station_pool.erase(it);
+        }
+    }
 
-        auto it = std::find_if(m_station_pool.begin(), m_station_pool.end(),
-                               [target_index](const auto& s) { return s->getID() == target_index; });
+    // The current candidate is started first, then outwards from it.
+    for (int distance = 0; distance <= std::max(m_preload_ahead, m_preload_behind); ++distance) {
+        for (int target_index : {m_current_index + distance, m_current_index - distance}) {
+            if (!is_in_preload_window(target_index) || m_loading.count(target_index))
+                continue;
+            bool is_pooled = std::any_of(m_station_pool.begin(), m_station_pool.end(),
+                                         [target_index](const auto& s) { return s->getID() == target_index; });
+            if (is_pooled)
+                continue;
 
-        if (it == m_station_pool.end()) {
             const auto& candidate = m_candidates[target_index];
-            auto new_station = std::make_unique<RadioStream>(target_index, candidate.name, candidate.urls);
-            new_station->initialize(0.0); // Start muted
-            new_station->setPlaybackState(PlaybackState::Muted);
-            m_station_pool.push_back(std::move(new_station));
+            m_loading[target_index] = std::async(
+                std::launch::async, [target_index, name = candidate.name, urls = candidate.urls, this] {
+                    auto station = std::make_unique<RadioStream>(target_index, name, urls);
+                    station->initialize(0.0); // Start muted
+                    station->setPlaybackState(PlaybackState::Muted);
+                    if (station->isInitialized()) {
+                        mpv_set_wakeup_callback(station->getMpvHandle(), notify_wakeup, &m_wakeup);
+                    }
+                    m_wakeup.notify(); // Lets the UI thread adopt it
+                    return station;
+                });
         }
     }
+    apply_playback_states();
+}
 
-    auto active_it = std::find_if(m_station_pool.begin(), m_station_pool.end(),
-                                  [this](const auto& s) { return s->getID() == m_current_index; });
-    if (active_it != m_station_pool.end()) {
-        if ((*active_it)->getPlaybackState() == PlaybackState::Muted && m_is_active_station_playing) {
-            (*active_it)->setPlaybackState(PlaybackState::Playing);
+bool CuratorApp::adopt_loaded_stations() {
+    bool active_arrived = false;
+    bool adopted = false;
+    for (auto it = m_loading.begin(); it != m_loading.end();) {
+        if (!is_ready(it->second)) {
+            ++it;
+            continue;
+        }
+        try {
+            auto station = it->second.get();
+            if (is_in_preload_window(it->first)) {
+                active_arrived = active_arrived || it->first == m_current_index;
+                m_station_pool.push_back(std::move(station));
+                adopted = true;
+            } else {
+                retire_station(std::move(station)); // The user moved on while it was loading
+            }
+        } catch (const std::exception&) {
+            // A candidate mpv can't open stays at "Connecting..."; the review goes on.
+        }
+        it = m_loading.erase(it);
+    }
+    if (adopted) {
+        apply_playback_states();
+    }
+    return active_arrived;
+}
+
+void CuratorApp::retire_station(std::unique_ptr<RadioStream> station) {
+    m_retiring.erase(std::remove_if(m_retiring.begin(), m_retiring.end(),
+                                    [](const std::future<void>& f) {
+                                        return f.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+                                    }),
+                     m_retiring.end());
+    // Stopping mpv joins its threads, which is too slow for the UI thread.
+    m_retiring.push_back(std::async(std::launch::async, [doomed = std::move(station)]() mutable { doomed.reset(); }));
+}
+
+void CuratorApp::apply_playback_states() {
+    for (const auto& station : m_station_pool) {
+        if (!station->isInitialized())
+            continue;
+        bool should_play = station->getID() == m_current_index && m_is_active_station_playing;
+        if (should_play && station->getPlaybackState() == PlaybackState::Muted) {
+            station->setPlaybackState(PlaybackState::Playing);
             double vol = 100.0;
-            mpv_set_property((*active_it)->getMpvHandle(), "volume", MPV_FORMAT_DOUBLE, &vol);
-        } else if ((*active_it)->getPlaybackState() == PlaybackState::Playing && !m_is_active_station_playing) {
-            (*active_it)->setPlaybackState(PlaybackState::Muted);
+            mpv_set_property(station->getMpvHandle(), "volume", MPV_FORMAT_DOUBLE, &vol);
+        } else if (!should_play && station->getPlaybackState() == PlaybackState::Playing) {
+            station->setPlaybackState(PlaybackState::Muted);
             double vol = 0.0;
-            mpv_set_property((*active_it)->getMpvHandle(), "volume", MPV_FORMAT_DOUBLE, &vol);
+            mpv_set_property(station->getMpvHandle(), "volume", MPV_FORMAT_DOUBLE, &vol);
         }
     }
 }
 
 void CuratorApp::advance(bool keep_current) {
+    if (m_current_index >= static_cast<int>(m_candidates.size()))
+        return; // Still waiting for the feed
     m_history.push_back(m_current_index);
 
-    if (m_current_index < static_cast<int>(m_candidates.size()) && keep_current) {
+    if (keep_current) {
         m_kept_stations.push_back(m_candidates[m_current_index]);
     } else {
         m_discarded_count++;
@@ -76,12 +170,7 @@ void CuratorApp::advance(bool keep_current) {
 
     m_current_index++;
     m_is_active_station_playing = true;
-
-    if (m_current_index >= static_cast<int>(m_candidates.size())) {
-        m_quit_flag = true;
-        return;
-    }
-    update_preloaded_stations();
+    update_preloaded_stations(); // run() ends the session if that was the last candidate
 }
 
 void CuratorApp::go_back() {
@@ -123,7 +212,9 @@ void CuratorApp::handle_edit_tags_action() {
     refresh();
 
     char input[256];
+    timeout(-1); // The main loop reads keys without blocking; this prompt must wait for Enter
     getnstr(input, sizeof(input) - 1);
+    nodelay(stdscr, TRUE);
 
     if (was_echo)
         noecho();
@@ -164,19 +255,8 @@ void CuratorApp::handle_play_toggle_action() {
         !(*active_station_iter)->isInitialized()) {
         return;
     }
-    RadioStream* active_station_ptr = (*active_station_iter).get();
-
-    if (active_station_ptr->getPlaybackState() == PlaybackState::Muted) {
-        active_station_ptr->setPlaybackState(PlaybackState::Playing);
-        m_is_active_station_playing = true;
-        double vol = 100.0;
-        mpv_set_property(active_station_ptr->getMpvHandle(), "volume", MPV_FORMAT_DOUBLE, &vol);
-    } else {
-        active_station_ptr->setPlaybackState(PlaybackState::Muted);
-        m_is_active_station_playing = false;
-        double vol = 0.0;
-        mpv_set_property(active_station_ptr->getMpvHandle(), "volume", MPV_FORMAT_DOUBLE, &vol);
-    }
+    m_is_active_station_playing = (*active_station_iter)->getPlaybackState() == PlaybackState::Muted;
+    apply_playback_states();
 }
 
 // --- Main Input Dispatcher ---
@@ -209,35 +289,69 @@ void CuratorApp::handle_input(int ch) {
     }
 }
 
-void CuratorApp::process_mpv_events_for_pool() {
-    for (const auto& station_ptr : m_station_pool) {
-        if (station_ptr && station_ptr->isInitialized()) {
-            char* title_cstr = nullptr;
-            if (mpv_get_property(station_ptr->getMpvHandle(), "media-title", MPV_FORMAT_STRING, &title_cstr) == 0) {
-                if (title_cstr) {
-                    station_ptr->setCurrentTitle(title_cstr);
-                    mpv_free(title_cstr);
-                }
-            }
-            int buffering_flag = 0;
-            if (mpv_get_property(station_ptr->getMpvHandle(), "core-idle", MPV_FORMAT_FLAG, &buffering_flag) == 0) {
-                station_ptr->setBuffering(buffering_flag);
-            }
-            int64_t bitrate_bps = 0;
-            if (mpv_get_property(station_ptr->getMpvHandle(), "audio-bitrate", MPV_FORMAT_INT64, &bitrate_bps) == 0) {
-                if (bitrate_bps > 0) {
-                    station_ptr->setBitrate(static_cast<int>(bitrate_bps / 1000));
-                }
-            }
+bool CuratorApp::pull_candidates() {
+    size_t previous_count = m_candidates.size();
+    m_feed_finished = m_feed.isFinished(); // Read first: once finished, everything has arrived
+    m_feed.takeArrived(m_candidates);
+    return m_candidates.size() > previous_count;
+}
 
-            if (station_ptr->getID() == m_current_index) {
-                m_is_active_station_playing = (station_ptr->getPlaybackState() == PlaybackState::Playing);
+bool CuratorApp::drain_mpv_events() {
+    bool active_changed = false;
+    for (const auto& station_ptr : m_station_pool) {
+        if (!station_ptr || !station_ptr->isInitialized())
+            continue;
+        while (true) {
+            mpv_event* event = mpv_wait_event(station_ptr->getMpvHandle(), 0);
+            if (event->event_id == MPV_EVENT_NONE)
+                break;
+            if (handle_mpv_event(*station_ptr, event) && station_ptr->getID() == m_current_index) {
+                active_changed = true;
             }
         }
     }
+    return active_changed;
+}
+
+// The pool's streams observe the same properties as the main player's (see
+// RadioStream::initialize), so their values arrive here instead of being polled.
+bool CuratorApp::handle_mpv_event(RadioStream& station, const mpv_event* event) {
+    if (event->event_id != MPV_EVENT_PROPERTY_CHANGE)
+        return false;
+    const auto* prop = static_cast<const mpv_event_property*>(event->data);
+
+    if (strcmp(prop->name, "media-title") == 0 && prop->format == MPV_FORMAT_STRING) {
+        const char* title_cstr = *static_cast<char**>(prop->data);
+        if (!title_cstr)
+            return false;
+        station.setCurrentTitle(title_cstr);
+    } else if (strcmp(prop->name, "audio-bitrate") == 0 && prop->format == MPV_FORMAT_INT64) {
+        int64_t bitrate_bps = *static_cast<int64_t*>(prop->data);
+        if (bitrate_bps <= 0)
+            return false;
+        station.setBitrate(static_cast<int>(bitrate_bps / 1000));
+    } else if (strcmp(prop->name, "core-idle") == 0 && prop->format == MPV_FORMAT_FLAG) {
+        station.setBuffering(*static_cast<int*>(prop->data));
+    } else {
+        return false;
+    }
+    return true;
+}
+
+void CuratorApp::wait_for_events() {
+    struct pollfd fds[] = {
+        {STDIN_FILENO, POLLIN, 0},
+        {m_wakeup.fd(), POLLIN, 0},
+    };
+    poll(fds, 2, -1); // EINTR (e.g. SIGWINCH) just leads to a getch() that reports it
+    // Drained before the mpv queues are, so an event queued meanwhile still wakes the next wait.
+    m_wakeup.drain();
 }
 
 std::string CuratorApp::get_active_station_status_string() const {
+    if (m_current_index >= static_cast<int>(m_candidates.size())) {
+        return "Fetching more candidates...";
+    }
     auto active_it = std::find_if(m_station_pool.begin(), m_station_pool.end(),
                                   [this](const auto& s) { return s && s->getID() == m_current_index; });
 
@@ -277,20 +391,36 @@ CuratorStation CuratorApp::get_station_display_data() const {
 }
 
 void CuratorApp::run() {
+    bool needs_redraw = true;
     while (!m_quit_flag) {
-        process_mpv_events_for_pool();
-
-        std::string status_string = get_active_station_status_string();
-        CuratorStation station_to_display = get_station_display_data();
+        if (pull_candidates()) {
+            update_preloaded_stations();
+            needs_redraw = true;
+        }
+        if (m_current_index >= static_cast<int>(m_candidates.size()) && m_feed_finished)
+            break;
+        if (adopt_loaded_stations()) {
+            needs_redraw = true;
+        }
+        if (drain_mpv_events()) {
+            needs_redraw = true;
+        }
+        if (needs_redraw) {
+            std::string status_string = get_active_station_status_string();
+            CuratorStation station_to_display = get_station_display_data();
 
-        m_ui->draw(m_genre, m_current_index, m_candidates.size(), m_kept_stations.size(), m_discarded_count,
-                   station_to_display, status_string, m_is_active_station_playing);
+            m_ui->draw(m_genre, m_current_index, m_candidates.size(), m_kept_stations.size(), m_discarded_count,
+                       station_to_display, status_string, m_is_active_station_playing);
+            needs_redraw = false;
+        }
 
         int ch = getch();
         if (ch != ERR) {
             handle_input(ch);
+            needs_redraw = true;
+            continue;
         }
-        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        wait_for_events();
     }
     save_curated_list();
 }
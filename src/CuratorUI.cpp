@@ -37,7 +37,7 @@ CuratorUI::CuratorUI() {
     noecho();
     curs_set(0);
     keypad(stdscr, TRUE);
-    timeout(100);
+    nodelay(stdscr, TRUE); // CuratorApp waits in poll() and only reads keys that have arrived
     init_colors();
 }
 
@@ -239,7 +239,7 @@ void CuratorUI::draw(const std::string& genre,
 
     // Format information
     y_pos += 2;
-    mvprintw(y_pos, 5, "🔊 Format: %s", station.format.c_str());
+    mvprintw(y_pos, 5, "🔊 Format: %s", station.format.empty() ? "unknown" : station.format.c_str());
 
     // Tags with edit indicator
     y_pos += 2;
@@ -5,6 +5,8 @@
 #include <unistd.h> // for sleep
 
 #include <algorithm>
+#include <chrono>
+#include <future>
 #include <set>
 #include <thread>
 
@@ -20,6 +22,9 @@ namespace {
     constexpr int COLOR_PAIR_CURSOR = 4;
     constexpr int COLOR_PAIR_SUCCESS = 5;
     constexpr int COLOR_PAIR_INFO = 6;
+
+    // How long to wait on one genre's fetch before checking the others.
+    constexpr std::chrono::milliseconds FETCH_POLL_INTERVAL(50);
 } // namespace
 
 FirstRunWizard::FirstRunWizard() { m_cli_handler = std::make_unique<CliHandler>(); }
@@ -224,19 +229,44 @@ void FirstRunWizard::handle_input(int ch) {
 }
 
 bool FirstRunWizard::perform_auto_curation() {
-    std::vector<CuratorStation> final_stations;
-    std::set<std::string> station_names; // For deduplication
-
+    const std::string title = "Building your custom radio...";
+    std::vector<std::string> genres;
     for (int index : m_selected_indices) {
-        const std::string& genre = m_available_genres[index];
-        draw_message_screen("Building your custom radio...", "Fetching stations for '" + genre + "'...");
+        genres.push_back(m_available_genres[index]);
+    }
 
-        auto candidates = m_cli_handler->get_curation_candidates(genre);
-        if (candidates.empty()) {
-            continue;
+    // Every genre is fetched at once; the mirror ranked while listing genres is
+    // shared, so no request repeats the lookup.
+    std::vector<std::future<std::vector<CuratorStation>>> fetches;
+    for (const auto& genre : genres) {
+        fetches.push_back(std::async(std::launch::async,
+                                     [this, genre] { return m_cli_handler->get_curation_candidates(genre); }));
+    }
+
+    std::vector<std::vector<CuratorStation>> results(genres.size());
+    std::vector<bool> fetched(genres.size(), false);
+    size_t fetched_count = 0;
+    draw_message_screen(title, "Fetching stations for " + std::to_string(genres.size()) + " genres...");
+    while (fetched_count < genres.size()) {
+        for (size_t i = 0; i < fetches.size(); ++i) {
+            if (fetched[i] || fetches[i].wait_for(FETCH_POLL_INTERVAL) != std::future_status::ready) {
+                continue;
+            }
+            results[i] = fetches[i].get();
+            fetched[i] = true;
+            ++fetched_count;
+            draw_message_screen(title,
+                                "Fetched " + std::to_string(fetched_count) + " of " + std::to_string(genres.size()) +
+                                    " genres",
+                                "'" + genres[i] + "': " + std::to_string(results[i].size()) + " stations");
         }
+    }
 
-        // The script already sorted by votes, but we can do it again just to be safe.
+    // Merged in selection order, so the list does not depend on which fetch finished first.
+    std::vector<CuratorStation> final_stations;
+    std::set<std::string> station_names; // For deduplication
+    for (auto& candidates : results) {
+        // The API already sorted by votes, but we can do it again just to be safe.
         std::sort(candidates.begin(), candidates.end(),
                   [](const CuratorStation& a, const CuratorStation& b) { return a.votes > b.votes; });
 
@@ -0,0 +1,131 @@
+#include "Net/HttpClient.h"
+
+#include <iterator>
+#include <streambuf>
+
+namespace {
+    constexpr const char* USER_AGENT = "stream-hopper/1.0";
+    // Longest single wait for socket activity; the transfer timeout still applies.
+    constexpr int SOCKET_WAIT_MS = 1000;
+
+    // Exposes a transfer in progress as a streambuf. Reading past what has
+    // arrived drives the transfer until more data comes in or it ends.
+    class TransferBuffer : public std::streambuf {
+      public:
+        explicit TransferBuffer(CURLM* multi) : m_multi(multi) {}
+
+        static size_t onData(char* data, size_t size, size_t count, void* self) {
+            static_cast<TransferBuffer*>(self)->m_pending.append(data, size * count);
+            return size * count;
+        }
+
+        bool finished() const { return m_finished; }
+        CURLcode result() const { return m_result; }
+        bool bodyStarted() const { return m_body_started; }
+
+      protected:
+        int_type underflow() override {
+            while (m_pending.empty() && !m_finished) {
+                pump();
+            }
+            if (m_pending.empty()) {
+                return traits_type::eof();
+            }
+            m_current.swap(m_pending);
+            m_pending.clear();
+            m_body_started = true;
+            setg(m_current.data(), m_current.data(), m_current.data() + m_current.size());
+            return traits_type::to_int_type(*gptr());
+        }
+
+      private:
+        void pump() {
+            int running = 0;
+            if (curl_multi_perform(m_multi, &running) != CURLM_OK) {
+                m_result = CURLE_FAILED_INIT;
+                m_finished = true;
+                return;
+            }
+            if (running == 0) {
+                int queued = 0;
+                while (CURLMsg* message = curl_multi_info_read(m_multi, &queued)) {
+                    if (message->msg == CURLMSG_DONE) {
+                        m_result = message->data.result;
+                    }
+                }
+                m_finished = true;
+                return;
+            }
+            curl_multi_wait(m_multi, nullptr, 0, SOCKET_WAIT_MS, nullptr);
+        }
+
+        CURLM* m_multi;
+        std::string m_pending; // Filled by libcurl
+        std::string m_current; // Being read by the consumer
+        CURLcode m_result = CURLE_OK;
+        bool m_finished = false;
+        bool m_body_started = false;
+    };
+} // namespace
+
+void ensure_curl_initialized() {
+    static const bool initialized = [] { return curl_global_init(CURL_GLOBAL_DEFAULT) == CURLE_OK; }();
+    if (!initialized) {
+        throw std::runtime_error("Could not initialize libcurl.");
+    }
+}
+
+HttpClient::HttpClient() {
+    ensure_curl_initialized();
+    m_easy = curl_easy_init();
+    m_multi = curl_multi_init();
+    if (!m_easy || !m_multi) {
+        if (m_easy)
+            curl_easy_cleanup(m_easy);
+        if (m_multi)
+            curl_multi_cleanup(m_multi);
+        throw std::runtime_error("Could not create an HTTP client.");
+    }
+}
+
+HttpClient::~HttpClient() {
+    curl_easy_cleanup(m_easy);
+    curl_multi_cleanup(m_multi);
+}
+
+std::string HttpClient::get(const std::string& url, std::chrono::milliseconds timeout) {
+    std::string body;
+    get(url, timeout, [&](std::istream& in) { body.assign(std::istreambuf_iterator<char>(in), {}); });
+    return body;
+}
+
+void HttpClient::get(const std::string& url,
+                     std::chrono::milliseconds timeout,
+                     const std::function<void(std::istream&)>& consume) {
+    TransferBuffer buffer(m_multi);
+    curl_easy_setopt(m_easy, CURLOPT_URL, url.c_str());
+    curl_easy_setopt(m_easy, CURLOPT_USERAGENT, USER_AGENT);
+    curl_easy_setopt(m_easy, CURLOPT_FOLLOWLOCATION, 1L);
+    curl_easy_setopt(m_easy, CURLOPT_FAILONERROR, 1L); // Error statuses fail before any body is delivered
+    curl_easy_setopt(m_easy, CURLOPT_ACCEPT_ENCODING, "");
+    curl_easy_setopt(m_easy, CURLOPT_NOSIGNAL, 1L);
+    curl_easy_setopt(m_easy, CURLOPT_TIMEOUT_MS, static_cast<long>(timeout.count()));
+    curl_easy_setopt(m_easy, CURLOPT_WRITEFUNCTION, &TransferBuffer::onData);
+    curl_easy_setopt(m_easy, CURLOPT_WRITEDATA, &buffer);
+    if (curl_multi_add_handle(m_multi, m_easy) != CURLM_OK) {
+        throw HttpError(url + ": could not start the request", false);
+    }
+
+    std::istream stream(&buffer);
+    try {
+        consume(stream);
+    } catch (...) {
+        curl_multi_remove_handle(m_multi, m_easy);
+        throw;
+    }
+    // Removing an unfinished transfer closes its connection; a finished one stays cached.
+    curl_multi_remove_handle(m_multi, m_easy);
+    if (buffer.finished() && buffer.result() != CURLE_OK) {
+        throw HttpError(url + ": " + curl_easy_strerror(buffer.result()), buffer.bodyStarted());
+    }
+}
@@ -0,0 +1,358 @@
+#include "Net/RadioBrowserClient.h"
+
+#include <netdb.h>
+#include <sys/socket.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iterator>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <streambuf>
+
+#include "Core/Metrics.h"
+#include "Net/HttpClient.h"
+#include "Net/ResponseCache.h"
+#include "nlohmann/json.hpp"
+
+namespace {
+    constexpr const char* MIRROR_POOL_HOST = "all.api.radio-browser.info";
+    constexpr const char* MIRRORS_ENV_VAR = "STREAM_HOPPER_API_MIRRORS";
+    constexpr const char* PROBE_PATH = "/json/stats";
+
+    constexpr std::chrono::hours MIRROR_RANKING_TTL(24);
+    constexpr std::chrono::milliseconds PROBE_TIMEOUT(3000);
+    constexpr std::chrono::milliseconds REQUEST_TIMEOUT(30000);
+    // Idle clients kept for reuse; the wizard runs a handful of requests at once.
+    constexpr size_t MAX_IDLE_CLIENTS = 8;
+
+    const std::string CACHE_DIRECTORY = "radio_api_cache";
+    constexpr const char* TAGS_PATH_PREFIX = "/json/tags";
+    constexpr const char* STATIONS_BY_TAG_PATH_PREFIX = "/json/stations/bytag/";
+    constexpr const char* TAGS_TTL_ENV_VAR = "STREAM_HOPPER_TAGS_CACHE_HOURS";
+    constexpr const char* STATIONS_TTL_ENV_VAR = "STREAM_HOPPER_STATIONS_CACHE_HOURS";
+    constexpr const char* CACHE_SIZE_ENV_VAR = "STREAM_HOPPER_API_CACHE_MB";
+    constexpr std::chrono::hours DEFAULT_TAGS_TTL(24);
+    constexpr std::chrono::hours DEFAULT_STATIONS_TTL(6);
+    constexpr size_t DEFAULT_CACHE_MB = 16;
+    // Past its TTL by more than this, an entry is refetched before being shown.
+    constexpr std::chrono::hours MAX_STALENESS(24 * 7);
+
+    std::chrono::seconds ttl_from_environment(const char* env_var, std::chrono::hours fallback) {
+        if (const char* value = std::getenv(env_var)) {
+            return std::chrono::hours(std::max(0, std::atoi(value)));
+        }
+        return fallback;
+    }
+
+    size_t cache_bytes_from_environment() {
+        size_t megabytes = DEFAULT_CACHE_MB;
+        if (const char* value = std::getenv(CACHE_SIZE_ENV_VAR)) {
+            megabytes = static_cast<size_t>(std::max(0, std::atoi(value)));
+        }
+        return megabytes * 1024 * 1024;
+    }
+
+    bool starts_with(const std::string& text, const char* prefix) { return text.rfind(prefix, 0) == 0; }
+
+    // Copies everything read through it, so a streamed body can be cached.
+    // Passes on whatever has arrived instead of waiting for a full chunk.
+    class TeeBuffer : public std::streambuf {
+      public:
+        TeeBuffer(std::streambuf& source, std::string& copy) : m_source(source), m_copy(copy) {}
+
+      protected:
+        int_type underflow() override {
+            if (m_source.sgetc() == traits_type::eof()) {
+                return traits_type::eof();
+            }
+            auto available = std::min<std::streamsize>(m_source.in_avail(), sizeof(m_chunk));
+            auto count = m_source.sgetn(m_chunk, std::max<std::streamsize>(available, 1));
+            m_copy.append(m_chunk, static_cast<size_t>(count));
+            setg(m_chunk, m_chunk, m_chunk + count);
+            return traits_type::to_int_type(*gptr());
+        }
+
+      private:
+        std::streambuf& m_source;
+        std::string& m_copy;
+        char m_chunk[4096];
+    };
+
+    std::vector<std::string> mirrors_from_environment() {
+        std::vector<std::string> urls;
+        const char* value = std::getenv(MIRRORS_ENV_VAR);
+        if (!value) {
+            return urls;
+        }
+        std::stringstream ss(value);
+        std::string url;
+        while (std::getline(ss, url, ',')) {
+            while (!url.empty() && (url.back() == '/' || url.back() == ' ')) {
+                url.pop_back();
+            }
+            url.erase(0, url.find_first_not_of(' '));
+            if (!url.empty()) {
+                urls.push_back(url);
+            }
+        }
+        return urls;
+    }
+
+    // Every address behind the pool name, by host name where reverse DNS has
+    // one (so TLS can be verified), otherwise by plain-HTTP address.
+    std::vector<std::string> mirrors_from_dns() {
+        std::vector<std::string> urls;
+        addrinfo hints{};
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;
+        addrinfo* results = nullptr;
+        if (getaddrinfo(MIRROR_POOL_HOST, nullptr, &hints, &results) != 0) {
+            return urls;
+        }
+        for (addrinfo* ai = results; ai; ai = ai->ai_next) {
+            char host[NI_MAXHOST];
+            std::string url;
+            if (getnameinfo(ai->ai_addr, ai->ai_addrlen, host, sizeof(host), nullptr, 0, NI_NAMEREQD) == 0) {
+                url = std::string("https://") + host;
+            } else if (getnameinfo(ai->ai_addr, ai->ai_addrlen, host, sizeof(host), nullptr, 0, NI_NUMERICHOST) == 0) {
+                url = ai->ai_family == AF_INET6 ? "http://[" + std::string(host) + "]" : "http://" + std::string(host);
+            }
+            if (!url.empty() && std::find(urls.begin(), urls.end(), url) == urls.end()) {
+                urls.push_back(url);
+            }
+        }
+        freeaddrinfo(results);
+        return urls;
+    }
+} // namespace
+
+RadioBrowserClient::RadioBrowserClient()
+    : m_mirrors_overridden(std::getenv(MIRRORS_ENV_VAR) != nullptr),
+      m_tags_ttl(ttl_from_environment(TAGS_TTL_ENV_VAR, DEFAULT_TAGS_TTL)),
+      m_stations_ttl(ttl_from_environment(STATIONS_TTL_ENV_VAR, DEFAULT_STATIONS_TTL)),
+      m_cache(std::make_unique<ResponseCache>(CACHE_DIRECTORY, cache_bytes_from_environment())) {}
+
+RadioBrowserClient::~RadioBrowserClient() {
+    // Refreshes use the cache and clients, so they must end before either goes.
+    for (auto& refresh : m_revalidations) {
+        refresh.wait();
+    }
+}
+
+std::string RadioBrowserClient::get(const std::string& path) {
+    std::string body;
+    get(path, [&](std::istream& in) { body.assign(std::istreambuf_iterator<char>(in), {}); });
+    return body;
+}
+
+void RadioBrowserClient::get(const std::string& path, const std::function<void(std::istream&)>& consume) {
+    auto ttl = cacheTtl(path);
+    if (!ttl) {
+        request(path,
+                [&](HttpClient& client, const std::string& url) { client.get(url, REQUEST_TIMEOUT, consume); });
+        return;
+    }
+
+    auto cached = m_cache->load(path);
+    if (cached && cached->age <= *ttl + MAX_STALENESS) {
+        if (cached->age <= *ttl) {
+            Metrics::increment("api.cache_hits");
+        } else {
+            Metrics::increment("api.cache_stale_hits");
+            revalidate(path);
+        }
+        std::istringstream in(cached->body);
+        consume(in);
+        return;
+    }
+
+    try {
+        fetchAndStore(path, consume);
+    } catch (const HttpError&) {
+        throw; // Part of the body was consumed already
+    } catch (const std::runtime_error&) {
+        if (!cached) {
+            throw;
+        }
+        Metrics::increment("api.cache_offline_hits");
+        std::istringstream in(cached->body);
+        consume(in);
+    }
+}
+
+std::optional<std::chrono::seconds> RadioBrowserClient::cacheTtl(const std::string& path) const {
+    std::chrono::seconds ttl(0);
+    if (starts_with(path, TAGS_PATH_PREFIX)) {
+        ttl = m_tags_ttl;
+    } else if (starts_with(path, STATIONS_BY_TAG_PATH_PREFIX)) {
+        ttl = m_stations_ttl;
+    }
+    if (ttl.count() == 0) {
+        return std::nullopt;
+    }
+    return ttl;
+}
+
+void RadioBrowserClient::fetchAndStore(const std::string& path, const std::function<void(std::istream&)>& consume) {
+    request(path, [&](HttpClient& client, const std::string& url) {
+        std::string body;
+        client.get(url, REQUEST_TIMEOUT, [&](std::istream& in) {
+            TeeBuffer tee(*in.rdbuf(), body);
+            std::istream teed(&tee);
+            consume(teed);
+            // Reads whatever the consumer left, so the whole body is cached.
+            teed.ignore(std::numeric_limits<std::streamsize>::max());
+        });
+        if (nlohmann::json::accept(body)) {
+            m_cache->store(path, body);
+        }
+    });
+}
+
+void RadioBrowserClient::revalidate(const std::string& path) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_revalidating.insert(path).second) {
+        return;
+    }
+    m_revalidations.erase(std::remove_if(m_revalidations.begin(), m_revalidations.end(),
+                                         [](const std::future<void>& refresh) {
+                                             return refresh.wait_for(std::chrono::seconds(0)) ==
+                                                    std::future_status::ready;
+                                         }),
+                          m_revalidations.end());
+    m_revalidations.push_back(std::async(std::launch::async, [this, path] {
+        try {
+            fetchAndStore(path, [](std::istream&) {});
+            Metrics::increment("api.cache_refreshes");
+        } catch (const std::exception&) {
+            // The stale entry stays until the next attempt
+        }
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_revalidating.erase(path);
+    }));
+}
+
+void RadioBrowserClient::request(const std::string& path,
+                                 const std::function<void(HttpClient&, const std::string&)>& attempt) {
+    auto client = acquireClient();
+    std::string last_error = "no mirrors found";
+    // A ranking read from disk may be out of date, so if none of it works the
+    // mirrors are ranked afresh and tried once more.
+    for (bool rerank : {false, true}) {
+        auto mirrors = mirrorsToTry(rerank);
+        for (const auto& mirror : mirrors) {
+            auto start = std::chrono::steady_clock::now();
+            try {
+                attempt(*client, mirror.base_url + path);
+            } catch (const HttpError& e) {
+                Metrics::increment("api.mirror_failures");
+                if (e.bodyStarted()) {
+                    throw;
+                }
+                last_error = e.what();
+                continue;
+            }
+            Metrics::recordDuration("api.request", std::chrono::steady_clock::now() - start);
+            markWorking(mirror.base_url);
+            releaseClient(std::move(client));
+            return;
+        }
+    }
+    throw std::runtime_error("Could not reach any Radio Browser API server (" + last_error + ")");
+}
+
+std::vector<ApiMirror> RadioBrowserClient::mirrorsToTry(bool rerank) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (rerank && !m_ranking_from_disk) {
+        return {}; // Already fresh; trying the same mirrors again would not help
+    }
+    if (rerank || m_mirrors.empty()) {
+        // Holding the lock makes concurrent first requests share one ranking.
+        m_mirrors = m_mirrors_overridden || rerank ? std::vector<ApiMirror>()
+                                                   : PersistenceManager().loadApiMirrors(MIRROR_RANKING_TTL);
+        m_ranking_from_disk = !m_mirrors.empty();
+        if (m_mirrors.empty()) {
+            m_mirrors = rankMirrors();
+            if (!m_mirrors_overridden && !m_mirrors.empty()) {
+                try {
+                    PersistenceManager().saveApiMirrors(m_mirrors);
+                } catch (const std::runtime_error&) {
+                    // Only costs a ranking on the next start
+                }
+            }
+        }
+        m_working_mirror.clear();
+    }
+
+    auto mirrors = m_mirrors;
+    auto working = std::find_if(mirrors.begin(), mirrors.end(),
+                                [this](const ApiMirror& mirror) { return mirror.base_url == m_working_mirror; });
+    if (working != mirrors.end()) {
+        std::rotate(mirrors.begin(), working, working + 1);
+    }
+    return mirrors;
+}
+
+std::vector<ApiMirror> RadioBrowserClient::rankMirrors() const {
+    auto start = std::chrono::steady_clock::now();
+    auto urls = m_mirrors_overridden ? mirrors_from_environment() : mirrors_from_dns();
+
+    // Every mirror is probed at once, so ranking takes as long as the slowest answer.
+    std::vector<std::future<std::optional<double>>> probes;
+    for (const auto& url : urls) {
+        probes.push_back(std::async(std::launch::async, [url]() -> std::optional<double> {
+            try {
+                HttpClient client;
+                auto probe_start = std::chrono::steady_clock::now();
+                client.get(url + PROBE_PATH, PROBE_TIMEOUT);
+                return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - probe_start)
+                    .count();
+            } catch (const std::runtime_error&) {
+                return std::nullopt;
+            }
+        }));
+    }
+
+    std::vector<ApiMirror> ranked;
+    for (size_t i = 0; i < urls.size(); ++i) {
+        if (auto latency = probes[i].get()) {
+            ranked.push_back({urls[i], *latency});
+        }
+    }
+    std::sort(ranked.begin(), ranked.end(),
+              [](const ApiMirror& a, const ApiMirror& b) { return a.latency_ms < b.latency_ms; });
+    Metrics::recordDuration("api.mirror_ranking", std::chrono::steady_clock::now() - start);
+    return ranked;
+}
+
+void RadioBrowserClient::markWorking(const std::string& base_url) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_working_mirror != base_url) {
+        if (!m_working_mirror.empty()) {
+            Metrics::increment("api.mirror_switches");
+        }
+        m_working_mirror = base_url;
+    }
+}
+
+std::unique_ptr<HttpClient> RadioBrowserClient::acquireClient() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_idle_clients.empty()) {
+            auto client = std::move(m_idle_clients.back());
+            m_idle_clients.pop_back();
+            return client;
+        }
+    }
+    return std::make_unique<HttpClient>();
+}
+
+void RadioBrowserClient::releaseClient(std::unique_ptr<HttpClient> client) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_idle_clients.size() < MAX_IDLE_CLIENTS) {
+        m_idle_clients.push_back(std::move(client));
+    }
+}
@@ -0,0 +1,109 @@
+#include "Net/ResponseCache.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+    constexpr const char* ENTRY_SUFFIX = ".response";
+
+    // FNV-1a; the key is also stored in the entry, so a collision is a miss.
+    std::uint64_t hash_key(const std::string& key) {
+        std::uint64_t hash = 14695981039346656037ull;
+        for (unsigned char c : key) {
+            hash = (hash ^ c) * 1099511628211ull;
+        }
+        return hash;
+    }
+} // namespace
+
+ResponseCache::ResponseCache(std::string directory, size_t max_bytes)
+    : m_directory(std::move(directory)), m_max_bytes(max_bytes) {}
+
+std::string ResponseCache::pathFor(const std::string& key) const {
+    char name[17];
+    std::snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(hash_key(key)));
+    return m_directory + "/" + name + ENTRY_SUFFIX;
+}
+
+std::optional<ResponseCache::Entry> ResponseCache::load(const std::string& key) const {
+    const std::string path = pathFor(key);
+    std::error_code ec;
+    auto modified = fs::last_write_time(path, ec);
+    if (ec) {
+        return std::nullopt;
+    }
+    std::ifstream in(path, std::ios::binary);
+    std::string stored_key;
+    if (!std::getline(in, stored_key) || stored_key != key) {
+        return std::nullopt;
+    }
+    Entry entry;
+    entry.body.assign(std::istreambuf_iterator<char>(in), {});
+    entry.age = std::chrono::duration_cast<std::chrono::system_clock::duration>(
+        fs::file_time_type::clock::now() - modified);
+    return entry;
+}
+
+void ResponseCache::store(const std::string& key, const std::string& body) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::error_code ec;
+    fs::create_directories(m_directory, ec);
+
+    // Written beside the entry and renamed over it, so readers never see half a body.
+    const std::string path = pathFor(key);
+    const std::string temp_path = path + ".tmp";
+    {
+        std::ofstream out(temp_path, std::ios::binary | std::ios::trunc);
+        out << key << '\n' << body;
+        if (!out.flush()) {
+            fs::remove(temp_path, ec);
+            return;
+        }
+    }
+    fs::rename(temp_path, path, ec);
+    if (ec) {
+        fs::remove(temp_path, ec);
+        return;
+    }
+    evictOverLimit();
+}
+
+void ResponseCache::evictOverLimit() {
+    struct CachedFile {
+        fs::path path;
+        fs::file_time_type modified;
+        std::uintmax_t size;
+    };
+    std::vector<CachedFile> files;
+    std::uintmax_t total = 0;
+    std::error_code ec;
+    for (const auto& item : fs::directory_iterator(m_directory, ec)) {
+        if (item.path().extension() != ENTRY_SUFFIX)
+            continue;
+        std::error_code item_ec;
+        CachedFile file{item.path(), item.last_write_time(item_ec), item.file_size(item_ec)};
+        if (item_ec)
+            continue;
+        total += file.size;
+        files.push_back(std::move(file));
+    }
+    if (total <= m_max_bytes)
+        return;
+
+    std::sort(files.begin(), files.end(),
+              [](const CachedFile& a, const CachedFile& b) { return a.modified < b.modified; });
+    for (const auto& file : files) {
+        if (total <= m_max_bytes)
+            break;
+        if (fs::remove(file.path, ec)) {
+            total -= file.size;
+        }
+    }
+}
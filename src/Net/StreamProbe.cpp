@@ -0,0 +1,140 @@
+#include "Net/StreamProbe.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <stdexcept>
+
+#include "Net/HttpClient.h" // For ensure_curl_initialized
+
+namespace {
+    constexpr const char* USER_AGENT = "stream-hopper/1.0";
+    // Enough audio to tell the codec and to show the stream is really flowing.
+    constexpr size_t SNIFF_BYTES = 8192;
+
+    struct ProbeState {
+        std::string content_type;
+        int bitrate = 0;
+        std::string head; // The first SNIFF_BYTES of the body
+    };
+
+    std::string trim_lower(std::string text) {
+        auto not_space = [](unsigned char c) { return !std::isspace(c); };
+        text.erase(text.begin(), std::find_if(text.begin(), text.end(), not_space));
+        text.erase(std::find_if(text.rbegin(), text.rend(), not_space).base(), text.end());
+        std::transform(text.begin(), text.end(), text.begin(), [](unsigned char c) { return std::tolower(c); });
+        return text;
+    }
+
+    size_t on_header(char* data, size_t size, size_t count, void* userdata) {
+        auto& state = *static_cast<ProbeState*>(userdata);
+        std::string line(data, size * count);
+        if (line.rfind("HTTP/", 0) == 0 || line.rfind("ICY ", 0) == 0) {
+            state = ProbeState{}; // A new response after a redirect
+            return size * count;
+        }
+        size_t colon = line.find(':');
+        if (colon == std::string::npos) {
+            return size * count;
+        }
+        std::string name = trim_lower(line.substr(0, colon));
+        std::string value = trim_lower(line.substr(colon + 1));
+        if (name == "content-type") {
+            state.content_type = value.substr(0, value.find(';'));
+        } else if (name == "icy-br") {
+            state.bitrate = std::atoi(value.c_str()); // May list several, e.g. "128,128"
+        } else if (name == "ice-audio-info" && state.bitrate == 0) {
+            size_t pos = value.find("bitrate=");
+            if (pos != std::string::npos) {
+                state.bitrate = std::atoi(value.c_str() + pos + 8);
+            }
+        }
+        return size * count;
+    }
+
+    size_t on_data(char* data, size_t size, size_t count, void* userdata) {
+        auto& state = *static_cast<ProbeState*>(userdata);
+        state.head.append(data, std::min(size * count, SNIFF_BYTES - state.head.size()));
+        return state.head.size() < SNIFF_BYTES ? size * count : 0; // Returning short hangs up
+    }
+
+    std::string codec_from_content_type(const std::string& type) {
+        if (type == "audio/mpeg" || type == "audio/mp3")
+            return "MP3";
+        if (type == "audio/aac" || type == "audio/aacp" || type == "audio/mp4")
+            return "AAC";
+        if (type == "audio/ogg" || type == "application/ogg" || type == "audio/opus")
+            return "OGG";
+        if (type == "audio/flac" || type == "audio/x-flac")
+            return "FLAC";
+        if (type == "application/vnd.apple.mpegurl" || type == "application/x-mpegurl")
+            return "HLS";
+        return "";
+    }
+
+    // For servers that send no or a generic content type.
+    std::string codec_from_bytes(const std::string& head) {
+        auto byte = [&](size_t i) { return static_cast<unsigned char>(head[i]); };
+        if (head.rfind("OggS", 0) == 0)
+            return "OGG";
+        if (head.rfind("fLaC", 0) == 0)
+            return "FLAC";
+        if (head.rfind("#EXTM3U", 0) == 0)
+            return "HLS";
+        if (head.rfind("ID3", 0) == 0)
+            return "MP3";
+        for (size_t i = 0; i + 1 < head.size(); ++i) {
+            if (byte(i) != 0xFF)
+                continue;
+            if ((byte(i + 1) & 0xF6) == 0xF0)
+                return "AAC"; // ADTS sync word, layer 0
+            if ((byte(i + 1) & 0xE0) == 0xE0)
+                return "MP3"; // MPEG audio frame sync
+        }
+        return "";
+    }
+} // namespace
+
+StreamProbe::StreamProbe() {
+    ensure_curl_initialized();
+    m_easy = curl_easy_init();
+    if (!m_easy) {
+        throw std::runtime_error("Could not create a stream probe.");
+    }
+}
+
+StreamProbe::~StreamProbe() { curl_easy_cleanup(m_easy); }
+
+StreamProbeResult StreamProbe::probe(const std::string& url, std::chrono::milliseconds timeout) {
+    ProbeState state;
+    curl_easy_reset(m_easy);
+    curl_easy_setopt(m_easy, CURLOPT_URL, url.c_str());
+    curl_easy_setopt(m_easy, CURLOPT_USERAGENT, USER_AGENT);
+    curl_easy_setopt(m_easy, CURLOPT_FOLLOWLOCATION, 1L);
+    curl_easy_setopt(m_easy, CURLOPT_FAILONERROR, 1L);
+    curl_easy_setopt(m_easy, CURLOPT_NOSIGNAL, 1L);
+    curl_easy_setopt(m_easy, CURLOPT_TIMEOUT_MS, static_cast<long>(timeout.count()));
+    curl_easy_setopt(m_easy, CURLOPT_HEADERFUNCTION, &on_header);
+    curl_easy_setopt(m_easy, CURLOPT_HEADERDATA, &state);
+    curl_easy_setopt(m_easy, CURLOPT_WRITEFUNCTION, &on_data);
+    curl_easy_setopt(m_easy, CURLOPT_WRITEDATA, &state);
+    CURLcode rc = curl_easy_perform(m_easy);
+
+    StreamProbeResult result;
+    // A stream never ends, so hanging up (or timing out) after some audio is success.
+    bool hung_up = rc == CURLE_WRITE_ERROR || rc == CURLE_OPERATION_TIMEDOUT;
+    if (state.head.empty() || (rc != CURLE_OK && !hung_up)) {
+        result.error = rc != CURLE_OK ? curl_easy_strerror(rc) : "No data";
+        return result;
+    }
+    double start_transfer_seconds = 0.0;
+    curl_easy_getinfo(m_easy, CURLINFO_STARTTRANSFER_TIME, &start_transfer_seconds);
+    result.reachable = true;
+    result.time_to_first_byte = std::chrono::milliseconds(static_cast<long>(start_transfer_seconds * 1000.0));
+    result.codec = codec_from_content_type(state.content_type);
+    if (result.codec.empty()) {
+        result.codec = codec_from_bytes(state.head);
+    }
+    result.bitrate = state.bitrate;
+    return result;
+}
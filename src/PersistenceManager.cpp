@@ -1,10 +1,22 @@
 #include "PersistenceManager.h"
 
+#include <sys/stat.h> // For stat
+#include <unistd.h>   // For fsync
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
 #include <fstream>
 #include <iomanip>
+#include <iterator>
+#include <sstream>
 #include <stdexcept> // For std::runtime_error
 
-#include "RadioStream.h"
+#include "Core/HistoryIndexFile.h"
+#include "Core/Metrics.h"
+#include "Core/SeenStationFilter.h"
+#include "Core/StationCatalog.h"
 #include "nlohmann/json.hpp"
 
 using nlohmann::json;
@@ -13,70 +25,480 @@ using nlohmann::json;
 const std::string FAVORITES_FILENAME = "radio_favorites.json";
 const std::string SESSION_FILENAME = "radio_session.json";
 const std::string HISTORY_FILENAME = "radio_history.json";
+const std::string HISTORY_INDEX_FILENAME = "radio_history.index";
 const std::string VOLUME_OFFSETS_FILENAME = "volume_offsets.jsonc";
+const std::string API_MIRRORS_FILENAME = "radio_api_mirrors.json";
+const std::string STATION_CATALOG_FILENAME = "radio_station_catalog.bin";
+const std::string SEEN_STATIONS_FILENAME = "radio_seen_stations.bin";
+const std::string STATION_HEALTH_FILENAME = "radio_station_health.json";
 
-std::optional<std::pair<std::string, std::vector<std::string>>>
-PersistenceManager::parse_single_station_entry(const json& station_entry) const {
-    if (!station_entry.is_object() || !station_entry.contains("name") || !station_entry.contains("urls")) {
-        return std::nullopt; // Not a valid station object
-    }
+namespace {
+    const std::string STATION_CACHE_SUFFIX = ".cache";
+    constexpr char STATION_CACHE_MAGIC[4] = {'S', 'H', 'S', 'C'};
+    constexpr std::uint32_t STATION_CACHE_VERSION = 2;
 
-    const auto& name_json = station_entry["name"];
-    const auto& urls_json = station_entry["urls"];
+    // Writes to a sibling temp file and renames it over the target, so a crash
+    // or full disk mid-write never leaves a truncated file behind.
+    void write_file_atomically(const std::string& filename, const std::string& content) {
+        const std::string temp_filename = filename + ".tmp";
 
-    if (!name_json.is_string() || !urls_json.is_array() || urls_json.empty()) {
-        return std::nullopt; // Invalid name or urls structure
+        FILE* out = fopen(temp_filename.c_str(), "wb");
+        if (!out) {
+            throw std::runtime_error("Could not open " + temp_filename + " for writing.");
+        }
+        bool ok = fwrite(content.data(), 1, content.size(), out) == content.size();
+        ok = (fflush(out) == 0) && ok;
+        ok = (fsync(fileno(out)) == 0) && ok;
+        ok = (fclose(out) == 0) && ok;
+        if (!ok || std::rename(temp_filename.c_str(), filename.c_str()) != 0) {
+            std::remove(temp_filename.c_str());
+            throw std::runtime_error("Failed to write " + filename + ".");
+        }
     }
 
-    std::string name = name_json.get<std::string>();
-    if (name.empty()) {
-        return std::nullopt; // Name cannot be empty
+    void write_json_atomically(const std::string& filename, const json& data) {
+        std::ostringstream ss;
+        ss << std::setw(4) << data << std::endl;
+        write_file_atomically(filename, ss.str());
     }
 
-    std::vector<std::string> urls;
-    for (const auto& url_entry : urls_json) {
-        if (url_entry.is_string()) {
-            std::string url_str = url_entry.get<std::string>();
-            if (!url_str.empty()) { // Ensure URL string is not empty
-                urls.push_back(url_str);
+    // Extracts station entries from a station list while it is being parsed.
+    // Entries are validated exactly as before: an object with a non-empty string
+    // "name" and a "urls" array holding at least one non-empty string. Anything
+    // else is silently skipped, as are unknown fields and nested values.
+    // "tags" is optional: an array of strings, or one comma-separated string.
+    class StationListSaxHandler : public nlohmann::json_sax<json> {
+      public:
+        explicit StationListSaxHandler(StationData& out) : m_out(out) {}
+
+        bool null() override { return scalar(nullptr); }
+        bool boolean(bool) override { return scalar(nullptr); }
+        bool number_integer(number_integer_t) override { return scalar(nullptr); }
+        bool number_unsigned(number_unsigned_t) override { return scalar(nullptr); }
+        bool number_float(number_float_t, const string_t&) override { return scalar(nullptr); }
+        bool binary(binary_t&) override { return scalar(nullptr); }
+        bool string(string_t& val) override { return scalar(&val); }
+
+        bool key(string_t& val) override {
+            if (m_depth == 2 && m_in_station) {
+                if (val == "name")
+                    m_field = Field::Name;
+                else if (val == "urls")
+                    m_field = Field::Urls;
+                else if (val == "tags")
+                    m_field = Field::Tags;
+                else
+                    m_field = Field::Other;
+            }
+            return true;
+        }
+
+        bool start_object(std::size_t) override {
+            if (m_depth == 0) {
+                return false; // Not a station list; stop early
+            }
+            if (m_depth == 1) {
+                m_in_station = true;
+                m_field = Field::Other;
+                m_name.reset();
+                m_urls.reset();
+                m_tags.clear();
+            } else {
+                invalidateCurrentField();
+            }
+            ++m_depth;
+            return true;
+        }
+
+        bool end_object() override {
+            --m_depth;
+            if (m_depth == 1 && m_in_station) {
+                if (m_name && !m_name->empty() && m_urls && !m_urls->empty()) {
+                    m_out.push_back({std::move(*m_name), std::move(*m_urls), std::move(m_tags)});
+                }
+                m_in_station = false;
+            }
+            return true;
+        }
+
+        bool start_array(std::size_t) override {
+            if (m_depth == 0) {
+                m_saw_top_level_array = true;
+            } else if (m_depth == 2 && m_in_station && m_field == Field::Urls) {
+                m_urls.emplace(); // A repeated key replaces the earlier value
+                m_in_urls = true;
+            } else if (m_depth == 2 && m_in_station && m_field == Field::Tags) {
+                m_tags.clear();
+                m_in_tags = true;
+            } else {
+                invalidateCurrentField();
+            }
+            ++m_depth;
+            return true;
+        }
+
+        bool end_array() override {
+            --m_depth;
+            if (m_depth == 2) {
+                m_in_urls = false;
+                m_in_tags = false;
+            }
+            return true;
+        }
+
+        bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception& ex) override {
+            m_parse_error = ex.what();
+            return false;
+        }
+
+        bool sawTopLevelArray() const { return m_saw_top_level_array; }
+        const std::string& parseError() const { return m_parse_error; }
+
+      private:
+        enum class Field { Other, Name, Urls, Tags };
+
+        bool scalar(string_t* val) {
+            if (m_depth == 0) {
+                return false; // Not a station list; stop early
+            }
+            if (m_depth == 2 && m_in_station && m_field == Field::Name) {
+                if (val) {
+                    m_name = std::move(*val);
+                } else {
+                    m_name.reset();
+                }
+            } else if (m_depth == 2 && m_in_station && m_field == Field::Urls) {
+                m_urls.reset();
+            } else if (m_depth == 2 && m_in_station && m_field == Field::Tags) {
+                m_tags.clear();
+                if (val) {
+                    std::stringstream tag_stream(*val);
+                    std::string tag;
+                    while (std::getline(tag_stream, tag, ',')) {
+                        if (!tag.empty())
+                            m_tags.push_back(tag);
+                    }
+                }
+            } else if (m_depth == 3 && m_in_urls && val && !val->empty()) {
+                m_urls->push_back(std::move(*val));
+            } else if (m_depth == 3 && m_in_tags && val && !val->empty()) {
+                m_tags.push_back(std::move(*val));
+            }
+            return true;
+        }
+
+        // A container where a scalar name, or a non-array urls, was expected.
+        void invalidateCurrentField() {
+            if (m_depth != 2 || !m_in_station) {
+                return;
+            }
+            if (m_field == Field::Name) {
+                m_name.reset();
+            } else if (m_field == Field::Urls) {
+                m_urls.reset();
+            } else if (m_field == Field::Tags) {
+                m_tags.clear();
+            }
+        }
+
+        StationData& m_out;
+        int m_depth = 0;
+        bool m_saw_top_level_array = false;
+        bool m_in_station = false;
+        bool m_in_urls = false;
+        bool m_in_tags = false;
+        Field m_field = Field::Other;
+        std::optional<std::string> m_name;
+        std::optional<std::vector<std::string>> m_urls;
+        std::vector<std::string> m_tags;
+        std::string m_parse_error;
+    };
+
+    // Streams radio_history.json ({"station": [["timestamp", "title"], ...]})
+    // and hands each well-formed entry to the visitor as soon as it is read.
+    // Malformed entries are skipped; a truncated file yields what came before.
+    class HistorySaxHandler : public nlohmann::json_sax<json> {
+      public:
+        explicit HistorySaxHandler(const PersistenceManager::HistoryVisitor& visitor) : m_visitor(visitor) {}
+
+        bool null() override { return scalar(nullptr); }
+        bool boolean(bool) override { return scalar(nullptr); }
+        bool number_integer(number_integer_t) override { return scalar(nullptr); }
+        bool number_unsigned(number_unsigned_t) override { return scalar(nullptr); }
+        bool number_float(number_float_t, const string_t&) override { return scalar(nullptr); }
+        bool binary(binary_t&) override { return scalar(nullptr); }
+        bool string(string_t& val) override { return scalar(&val); }
+
+        bool key(string_t& val) override {
+            if (m_depth == 1) {
+                m_station_name = std::move(val);
             }
+            return true;
         }
+
+        bool start_object(std::size_t) override {
+            m_entry_valid = false; // Only meaningful inside an entry
+            ++m_depth;
+            return true;
+        }
+
+        bool end_object() override {
+            --m_depth;
+            return true;
+        }
+
+        bool start_array(std::size_t) override {
+            if (m_depth == 0) {
+                return false; // Not a history file
+            }
+            if (m_depth == 1) {
+                m_in_station = true;
+            } else if (m_depth == 2 && m_in_station) {
+                m_entry_field = 0;
+                m_entry_valid = true;
+            } else {
+                m_entry_valid = false;
+            }
+            ++m_depth;
+            return true;
+        }
+
+        bool end_array() override {
+            --m_depth;
+            if (m_depth == 2 && m_in_station && m_entry_valid && m_entry_field == 2) {
+                m_visitor(m_station_name, m_timestamp, m_title);
+            } else if (m_depth == 1) {
+                m_in_station = false;
+            }
+            return true;
+        }
+
+        bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception&) override {
+            return false;
+        }
+
+      private:
+        bool scalar(string_t* val) {
+            if (m_depth == 0) {
+                return false; // Not a history file
+            }
+            if (m_depth == 3 && m_in_station) {
+                if (!val) {
+                    m_entry_valid = false;
+                } else if (m_entry_field == 0) {
+                    m_timestamp = std::move(*val);
+                } else if (m_entry_field == 1) {
+                    m_title = std::move(*val);
+                }
+                ++m_entry_field;
+            }
+            return true;
+        }
+
+        const PersistenceManager::HistoryVisitor& m_visitor;
+        int m_depth = 0;
+        bool m_in_station = false;
+        bool m_entry_valid = false;
+        int m_entry_field = 0;
+        std::string m_station_name;
+        std::string m_timestamp;
+        std::string m_title;
+    };
+
+    std::optional<HistoryIndexSource> stat_history_file() {
+        struct stat file_info{};
+        if (stat(HISTORY_FILENAME.c_str(), &file_info) != 0) {
+            return std::nullopt;
+        }
+        return HistoryIndexSource{static_cast<std::uint64_t>(file_info.st_size),
+                                  static_cast<std::int64_t>(file_info.st_mtim.tv_sec),
+                                  static_cast<std::int64_t>(file_info.st_mtim.tv_nsec)};
     }
 
-    if (urls.empty()) {
-        return std::nullopt; // Must have at least one valid URL
+    // --- Binary station cache ---
+    // Layout: magic, version, key (path, size, mtime), station count, then each
+    // station as a length-prefixed name followed by counted lists of urls and tags.
+    // All integers are native-endian; the cache never leaves this machine.
+
+    struct StationCacheKey {
+        std::string path;
+        std::uint64_t size;
+        std::int64_t mtime_sec;
+        std::int64_t mtime_nsec;
+    };
+
+    class CacheWriter {
+      public:
+        template <typename T> void put(const T& value) {
+            m_buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+        }
+        void putString(const std::string& str) {
+            put(static_cast<std::uint32_t>(str.size()));
+            m_buffer.append(str);
+        }
+        const std::string& buffer() const { return m_buffer; }
+
+      private:
+        std::string m_buffer;
+    };
+
+    class CacheReader {
+      public:
+        explicit CacheReader(const std::string& buffer) : m_buffer(buffer) {}
+
+        template <typename T> bool get(T& value) {
+            if (m_buffer.size() - m_pos < sizeof(T)) {
+                return false;
+            }
+            std::memcpy(&value, m_buffer.data() + m_pos, sizeof(T));
+            m_pos += sizeof(T);
+            return true;
+        }
+        bool getString(std::string& str) {
+            std::uint32_t length = 0;
+            if (!get(length) || m_buffer.size() - m_pos < length) {
+                return false;
+            }
+            str.assign(m_buffer, m_pos, length);
+            m_pos += length;
+            return true;
+        }
+        bool atEnd() const { return m_pos == m_buffer.size(); }
+
+      private:
+        const std::string& m_buffer;
+        size_t m_pos = 0;
+    };
+
+    std::optional<StationData> read_station_cache(const std::string& cache_filename, const StationCacheKey& key) {
+        std::ifstream in(cache_filename, std::ios::binary);
+        if (!in.is_open()) {
+            return std::nullopt;
+        }
+        std::string buffer((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        CacheReader reader(buffer);
+
+        char magic[sizeof(STATION_CACHE_MAGIC)] = {};
+        std::uint32_t version = 0;
+        StationCacheKey stored{};
+        if (!reader.get(magic) || std::memcmp(magic, STATION_CACHE_MAGIC, sizeof(magic)) != 0 ||
+            !reader.get(version) || version != STATION_CACHE_VERSION || !reader.getString(stored.path) ||
+            !reader.get(stored.size) || !reader.get(stored.mtime_sec) || !reader.get(stored.mtime_nsec)) {
+            return std::nullopt;
+        }
+        if (stored.path != key.path || stored.size != key.size || stored.mtime_sec != key.mtime_sec ||
+            stored.mtime_nsec != key.mtime_nsec) {
+            return std::nullopt; // The list changed since the cache was written
+        }
+
+        std::uint32_t station_count = 0;
+        if (!reader.get(station_count)) {
+            return std::nullopt;
+        }
+        StationData stations;
+        for (std::uint32_t s = 0; s < station_count; ++s) {
+            std::string name;
+            std::uint32_t url_count = 0;
+            if (!reader.getString(name) || !reader.get(url_count)) {
+                return std::nullopt;
+            }
+            std::vector<std::string> urls(url_count);
+            for (auto& url : urls) {
+                if (!reader.getString(url)) {
+                    return std::nullopt;
+                }
+            }
+            std::uint32_t tag_count = 0;
+            if (!reader.get(tag_count)) {
+                return std::nullopt;
+            }
+            std::vector<std::string> tags(tag_count);
+            for (auto& tag : tags) {
+                if (!reader.getString(tag)) {
+                    return std::nullopt;
+                }
+            }
+            stations.push_back({std::move(name), std::move(urls), std::move(tags)});
+        }
+        if (!reader.atEnd() || stations.empty()) {
+            return std::nullopt;
+        }
+        return stations;
     }
 
-    return std::make_pair(name, urls);
+    void write_station_cache(const std::string& cache_filename,
+                             const StationCacheKey& key,
+                             const StationData& stations) {
+        CacheWriter writer;
+        writer.put(STATION_CACHE_MAGIC);
+        writer.put(STATION_CACHE_VERSION);
+        writer.putString(key.path);
+        writer.put(key.size);
+        writer.put(key.mtime_sec);
+        writer.put(key.mtime_nsec);
+        writer.put(static_cast<std::uint32_t>(stations.size()));
+        for (const auto& station : stations) {
+            writer.putString(station.name);
+            writer.put(static_cast<std::uint32_t>(station.urls.size()));
+            for (const auto& url : station.urls) {
+                writer.putString(url);
+            }
+            writer.put(static_cast<std::uint32_t>(station.tags.size()));
+            for (const auto& tag : station.tags) {
+                writer.putString(tag);
+            }
+        }
+        write_file_atomically(cache_filename, writer.buffer());
+    }
 }
 
 StationData PersistenceManager::loadStations(const std::string& filename) const {
-    std::ifstream i(filename);
-    if (!i.is_open()) {
+    auto start = std::chrono::steady_clock::now();
+    struct stat file_info{};
+    if (stat(filename.c_str(), &file_info) != 0) {
         throw std::runtime_error("Could not open station file: " + filename +
                                  ". Please ensure the file exists in the same directory as the executable.");
     }
 
+    const StationCacheKey key{filename,
+                              static_cast<std::uint64_t>(file_info.st_size),
+                              static_cast<std::int64_t>(file_info.st_mtim.tv_sec),
+                              static_cast<std::int64_t>(file_info.st_mtim.tv_nsec)};
+    const std::string cache_filename = filename + STATION_CACHE_SUFFIX;
+    if (auto cached = read_station_cache(cache_filename, key)) {
+        Metrics::increment("stations.cache_hit");
+        Metrics::recordDuration("stations.load", std::chrono::steady_clock::now() - start);
+        return std::move(*cached);
+    }
+
+    std::ifstream i(filename, std::ios::binary);
+    if (!i.is_open()) {
+        throw std::runtime_error("Could not open station file: " + filename +
+                                 ". Please ensure the file exists in the same directory as the executable.");
+    }
+    // Stream the file through a SAX handler instead of building a DOM or reading
+    // it whole; only the name/urls pairs we keep are ever allocated.
     StationData station_data_list;
-    try {
-        json root_json = json::parse(i, nullptr, true, true); // Allow comments
-        if (!root_json.is_array()) {
-            throw std::runtime_error(filename + " must contain a top-level JSON array.");
-        }
-        for (const auto& station_entry_json : root_json) {
-            if (auto parsed_station = parse_single_station_entry(station_entry_json)) {
-                station_data_list.push_back(*parsed_station);
-            }
-            // If parse_single_station_entry returns nullopt, we silently skip the invalid entry.
-            // This makes loading more robust to malformed entries in user-provided files.
-        }
-    } catch (const json::parse_error& e) {
-        throw std::runtime_error("Failed to parse " + filename + ": " + std::string(e.what()));
+    StationListSaxHandler handler(station_data_list);
+    json::sax_parse(i, &handler, json::input_format_t::json, true, true); // Allow comments
+    if (!handler.parseError().empty()) {
+        throw std::runtime_error("Failed to parse " + filename + ": " + handler.parseError());
+    }
+    if (!handler.sawTopLevelArray()) {
+        throw std::runtime_error(filename + " must contain a top-level JSON array.");
     }
 
     if (station_data_list.empty()) {
         throw std::runtime_error(filename + " is empty or contains no valid station entries.");
     }
+
+    try {
+        write_station_cache(cache_filename, key, station_data_list);
+    } catch (const std::runtime_error&) {
+        // The cache is only an accelerator; a read-only directory is fine.
+    }
+    Metrics::increment("stations.cache_miss");
+    Metrics::recordDuration("stations.load", std::chrono::steady_clock::now() - start);
     return station_data_list;
 }
 
@@ -96,27 +518,76 @@ void PersistenceManager::saveSimpleStationList(const std::string& filename,
     }
 }
 
-json PersistenceManager::loadHistory() const {
+void PersistenceManager::scanHistory(const HistoryVisitor& visitor) const {
     std::ifstream i(HISTORY_FILENAME);
-    if (i.is_open()) {
-        try {
-            json history_data;
-            i >> history_data;
-            if (history_data.is_object()) {
-                return history_data;
-            }
-        } catch (...) {
-            // Silently ignore parse errors for history, return empty object
+    if (!i.is_open()) {
+        return;
+    }
+    HistorySaxHandler handler(visitor);
+    json::sax_parse(i, &handler);
+}
+
+SongHistory PersistenceManager::loadHistory() const {
+    SongHistory history;
+    // Timestamps are parsed once here; the UI only ever sees epoch seconds.
+    scanHistory([&history](const std::string& station_name, const std::string& timestamp, const std::string& title) {
+        std::time_t ts = SongHistory::parseTimestamp(timestamp);
+        if (ts >= 0) {
+            history.add(station_name, ts, title);
+        } else {
+            history.addUnparsed({station_name, timestamp, title}); // Kept so saving does not lose it
+        }
+    });
+    return history;
+}
+
+void PersistenceManager::saveHistory(const SongHistory& history) const {
+    json history_data = json::object();
+    // Unparseable entries go back first, ahead of each station's dated entries.
+    for (const auto& entry : history.unparsed()) {
+        history_data[entry.station_name].push_back({entry.timestamp, entry.title});
+    }
+    for (const auto& [station_name, entries] : history.stations()) {
+        json& station_entries = history_data[station_name];
+        for (const auto& entry : entries) {
+            station_entries.push_back({SongHistory::formatTimestamp(entry.timestamp), history.title(entry.title_id)});
         }
     }
-    return json::object();
+    write_json_atomically(HISTORY_FILENAME, history_data);
 }
 
-void PersistenceManager::saveHistory(const json& history_data) const {
-    std::ofstream o(HISTORY_FILENAME);
-    if (o.is_open()) {
-        o << std::setw(4) << history_data << std::endl;
+void PersistenceManager::saveHistoryIndex(const SongHistory& history) const {
+    auto source = stat_history_file();
+    if (!source) {
+        return;
     }
+    write_file_atomically(HISTORY_INDEX_FILENAME, HistoryIndexFile::serialize(history, *source));
+}
+
+bool PersistenceManager::openHistoryIndex(HistoryIndexFile& index) const {
+    auto source = stat_history_file();
+    return source && index.open(HISTORY_INDEX_FILENAME, *source);
+}
+
+void PersistenceManager::saveStationCatalog(std::vector<CuratorStation> stations, std::time_t newest_change) const {
+    write_file_atomically(STATION_CATALOG_FILENAME, StationCatalog::serialize(std::move(stations), newest_change));
+}
+
+bool PersistenceManager::openStationCatalog(StationCatalog& catalog) const {
+    return catalog.open(STATION_CATALOG_FILENAME);
+}
+
+bool PersistenceManager::loadSeenStations(SeenStationFilter& filter) const {
+    std::ifstream in(SEEN_STATIONS_FILENAME, std::ios::binary);
+    if (!in.is_open()) {
+        return false;
+    }
+    std::string data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    return filter.deserialize(data);
+}
+
+void PersistenceManager::saveSeenStations(const SeenStationFilter& filter) const {
+    write_file_atomically(SEEN_STATIONS_FILENAME, filter.serialize());
 }
 
 std::unordered_set<std::string> PersistenceManager::loadFavoriteNames() const {
@@ -142,18 +613,8 @@ std::unordered_set<std::string> PersistenceManager::loadFavoriteNames() const {
     return favorite_set;
 }
 
-void PersistenceManager::saveFavorites(const std::vector<RadioStream>& stations) const {
-    json fav_names = json::array();
-    for (const auto& station : stations) {
-        if (station.isFavorite()) {
-            fav_names.push_back(station.getName());
-        }
-    }
-
-    std::ofstream o(FAVORITES_FILENAME);
-    if (o.is_open()) {
-        o << std::setw(4) << fav_names << std::endl;
-    }
+void PersistenceManager::saveFavorites(const std::vector<std::string>& favorite_names) const {
+    write_json_atomically(FAVORITES_FILENAME, favorite_names);
 }
 
 std::optional<std::string> PersistenceManager::loadLastStationName() const {
@@ -178,10 +639,77 @@ void PersistenceManager::saveSession(const std::string& last_station_name) const
         return;
     json session_data;
     session_data["last_station_name"] = last_station_name;
-    std::ofstream o(SESSION_FILENAME);
-    if (o.is_open()) {
-        o << std::setw(4) << session_data << std::endl;
+    write_json_atomically(SESSION_FILENAME, session_data);
+}
+
+std::vector<ApiMirror> PersistenceManager::loadApiMirrors(std::chrono::seconds max_age) const {
+    std::vector<ApiMirror> mirrors;
+    std::ifstream i(API_MIRRORS_FILENAME);
+    if (!i.is_open()) {
+        return mirrors;
     }
+    try {
+        json data = json::parse(i);
+        std::chrono::seconds ranked_at(data.at("ranked_at").get<long long>());
+        auto now = std::chrono::system_clock::now().time_since_epoch();
+        if (now - ranked_at > max_age) {
+            return mirrors;
+        }
+        for (const auto& entry : data.at("mirrors")) {
+            mirrors.push_back({entry.at("url").get<std::string>(), entry.value("latency_ms", 0.0)});
+        }
+    } catch (const json::exception&) {
+        mirrors.clear(); // Re-ranked and rewritten on the next request
+    }
+    return mirrors;
+}
+
+void PersistenceManager::saveApiMirrors(const std::vector<ApiMirror>& mirrors) const {
+    json data;
+    data["ranked_at"] =
+        std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+    data["mirrors"] = json::array();
+    for (const auto& mirror : mirrors) {
+        data["mirrors"].push_back({{"url", mirror.base_url}, {"latency_ms", mirror.latency_ms}});
+    }
+    write_json_atomically(API_MIRRORS_FILENAME, data);
+}
+
+std::map<std::string, UrlHealth> PersistenceManager::loadStationHealth() const {
+    std::map<std::string, UrlHealth> health;
+    std::ifstream i(STATION_HEALTH_FILENAME);
+    if (!i.is_open()) {
+        return health;
+    }
+    try {
+        json data = json::parse(i);
+        for (const auto& [url, entry] : data.items()) {
+            UrlHealth h;
+            h.reliability = entry.value("reliability", 0.0);
+            h.time_to_first_byte_ms = entry.value("ttfb_ms", 0);
+            h.codec = entry.value("codec", "");
+            h.bitrate = entry.value("bitrate", 0);
+            h.last_checked = entry.value("last_checked", static_cast<std::time_t>(0));
+            h.consecutive_failures = entry.value("consecutive_failures", 0);
+            health[url] = h;
+        }
+    } catch (const json::exception&) {
+        health.clear(); // Every URL is simply probed again
+    }
+    return health;
+}
+
+void PersistenceManager::saveStationHealth(const std::map<std::string, UrlHealth>& health) const {
+    json data = json::object();
+    for (const auto& [url, h] : health) {
+        data[url] = {{"reliability", h.reliability},
+                     {"ttfb_ms", h.time_to_first_byte_ms},
+                     {"codec", h.codec},
+                     {"bitrate", h.bitrate},
+                     {"last_checked", h.last_checked},
+                     {"consecutive_failures", h.consecutive_failures}};
+    }
+    write_json_atomically(STATION_HEALTH_FILENAME, data);
 }
 
 std::map<std::string, double> PersistenceManager::loadVolumeOffsets() const {
@@ -206,9 +734,5 @@ std::map<std::string, double> PersistenceManager::loadVolumeOffsets() const {
 }
 
 void PersistenceManager::saveVolumeOffsets(const std::map<std::string, double>& offsets) const {
-    json data = offsets;
-    std::ofstream o(VOLUME_OFFSETS_FILENAME);
-    if (o.is_open()) {
-        o << std::setw(4) << data << std::endl;
-    }
+    write_json_atomically(VOLUME_OFFSETS_FILENAME, offsets);
 }
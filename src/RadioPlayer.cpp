@@ -3,6 +3,7 @@
 #include <ncurses.h>
 
 #include <cctype> // for tolower
+#include <chrono>
 #include <iostream>
 #include <thread>
 
@@ -12,12 +13,18 @@
 #include "Utils.h"
 
 namespace {
-    constexpr auto ACTOR_POLL_INTERVAL = std::chrono::milliseconds(100);
-    constexpr auto UI_IDLE_SLEEP = std::chrono::milliseconds(10);
+    constexpr auto BACKGROUND_CHECK_INTERVAL = std::chrono::milliseconds(100);
+    constexpr int KEY_ESCAPE = 27;
+    constexpr int KEY_ASCII_DELETE = 127;
+    constexpr int KEY_ASCII_BACKSPACE = 8;
 }
 
-RadioPlayer::RadioPlayer(StationManager& manager) : m_station_manager(manager) {
+RadioPlayer::RadioPlayer(StationManager& manager)
+    : m_station_manager(manager), m_render_settings(RenderSettings::fromEnvironment()),
+      m_frame_scheduler(m_render_settings.max_fps) {
     m_ui = std::make_unique<UIManager>();
+    m_ui->setAnimationsEnabled(m_render_settings.animations_enabled);
+    m_station_manager.setAnimationsEnabled(m_render_settings.animations_enabled);
     m_input_handlers = {
         {KEY_UP, Msg::NavigateUp{}},
         {KEY_DOWN, Msg::NavigateDown{}},
@@ -42,48 +49,130 @@ RadioPlayer::RadioPlayer(StationManager& manager) : m_station_manager(manager) {
 RadioPlayer::~RadioPlayer() = default;
 
 void RadioPlayer::run() {
-    auto last_poll_time = std::chrono::steady_clock::now();
+    bool needs_full_repaint = false;
 
     while (!m_station_manager.getQuitFlag()) {
-        if (m_station_manager.getNeedsRedrawFlag().exchange(false)) {
+        if (m_ui->takeSuspendRequest()) {
+            m_ui->suspend();
+            needs_full_repaint = true;
+        }
+        if (!m_ui->isForeground()) {
+            // Continued in the background: the actor keeps the audio going, but
+            // take no snapshots, draw nothing and leave the terminal alone.
+            std::this_thread::sleep_for(BACKGROUND_CHECK_INTERVAL);
+            needs_full_repaint = true;
+            continue;
+        }
+        if (needs_full_repaint) {
+            m_ui->invalidateScreen();
+            m_frame_scheduler.requestFrame();
+            needs_full_repaint = false;
+        }
+
+        auto now = std::chrono::steady_clock::now();
+        if (m_station_manager.takeRedrawRequest()) {
+            m_frame_scheduler.requestFrame();
+        }
+        if (m_frame_scheduler.isFrameDue(now)) {
             auto snapshot = m_station_manager.createSnapshot();
             m_ui->draw(snapshot);
-            m_ui->setInputTimeout(snapshot.is_copy_mode_active ? -1 : 100);
+            m_station_manager.setViewportRows(m_ui->getStationViewportRows());
+            m_is_copy_mode_active = snapshot.is_copy_mode_active;
+            if (snapshot.search_requests_handled == m_search_requests_posted) {
+                m_is_search_active = snapshot.is_search_active;
+            }
+            m_frame_scheduler.frameRendered(now);
         }
 
-        int ch = m_ui->getInput();
-
-        if (ch != ERR) {
-            if (ch == KEY_RESIZE) {
-                m_station_manager.getNeedsRedrawFlag() = true;
-                continue;
-            }
+        for (int ch = m_ui->getInput(); ch != ERR; ch = m_ui->getInput()) {
+            handleInput(ch);
+        }
 
-            auto snapshot = m_station_manager.createSnapshot();
-            if (snapshot.is_copy_mode_active) {
-                // Pass the character directly if it's a letter.
-                if (isalpha(ch)) {
-                    m_station_manager.post(Msg::SearchOnline{(char) tolower(ch)});
-                }
-                // Always exit the mode after a key press
-                m_station_manager.post(Msg::ToggleCopyMode{});
-
-            } else {
-                // Handle case-insensitivity for normal mode keys
-                int lower_ch = tolower(ch);
-                if (m_input_handlers.count(lower_ch)) {
-                    m_station_manager.post(m_input_handlers.at(lower_ch));
-                } else if (m_input_handlers.count(ch)) { // For non-alpha keys like KEY_UP
-                    m_station_manager.post(m_input_handlers.at(ch));
-                }
-            }
+        // Sleep until a key, a signal or a redraw request arrives, or a frame the
+        // scheduler is holding back falls due. Copy mode freezes the screen
+        // until a key is pressed, so it ignores redraw requests.
+        if (m_is_copy_mode_active) {
+            m_ui->waitForEvents(-1, -1);
         } else {
-            auto now = std::chrono::steady_clock::now();
-            if (now - last_poll_time > ACTOR_POLL_INTERVAL) {
-                m_station_manager.post(Msg::UpdateAndPoll{});
-                last_poll_time = now;
-            }
-            std::this_thread::sleep_for(UI_IDLE_SLEEP);
+            int timeout_ms = m_frame_scheduler.isFramePending()
+                                 ? m_frame_scheduler.msUntilDue(std::chrono::steady_clock::now())
+                                 : -1;
+            m_ui->waitForEvents(m_station_manager.getUiWakeupFd(), timeout_ms);
+        }
+    }
+}
+
+void RadioPlayer::handleInput(int ch) {
+    if (ch == KEY_RESIZE) {
+        m_station_manager.requestRedraw();
+        return;
+    }
+
+    if (m_is_search_active) {
+        handleSearchInput(ch);
+        return;
+    }
+
+    // Keys are interpreted against the last frame, which is what the user sees.
+    // The screen is frozen in copy mode though, so the actor may have timed it
+    // out since; a stale flag would toggle it back on.
+    if (m_is_copy_mode_active && !m_station_manager.createSnapshot().is_copy_mode_active) {
+        m_is_copy_mode_active = false;
+    }
+    if (m_is_copy_mode_active) {
+        // Pass the character directly if it's a letter.
+        if (isalpha(ch)) {
+            m_station_manager.post(Msg::SearchOnline{(char) tolower(ch)});
+        }
+        // Always exit the mode after a key press
+        m_station_manager.post(Msg::ToggleCopyMode{});
+        m_is_copy_mode_active = false;
+
+    } else if (ch == '/' || tolower(ch) == 'h') {
+        m_is_search_active = true;
+        m_search_requests_posted++;
+        m_station_manager.post(Msg::OpenSearch{ch == '/' ? SearchScope::STATIONS : SearchScope::HISTORY});
+    } else {
+        // Handle case-insensitivity for normal mode keys
+        int lower_ch = tolower(ch);
+        if (m_input_handlers.count(lower_ch)) {
+            m_station_manager.post(m_input_handlers.at(lower_ch));
+        } else if (m_input_handlers.count(ch)) { // For non-alpha keys like KEY_UP
+            m_station_manager.post(m_input_handlers.at(ch));
+        }
+    }
+}
+
+void RadioPlayer::handleSearchInput(int ch) {
+    switch (ch) {
+    case KEY_ESCAPE:
+        m_is_search_active = false;
+        m_search_requests_posted++;
+        m_station_manager.post(Msg::SearchCancel{});
+        break;
+    case KEY_ENTER:
+    case '\n':
+    case '\r':
+        m_is_search_active = false;
+        m_search_requests_posted++;
+        m_station_manager.post(Msg::SearchConfirm{});
+        break;
+    case KEY_UP:
+        m_station_manager.post(Msg::SearchMove{-1});
+        break;
+    case KEY_DOWN:
+        m_station_manager.post(Msg::SearchMove{1});
+        break;
+    case KEY_BACKSPACE:
+    case KEY_ASCII_DELETE:
+    case KEY_ASCII_BACKSPACE:
+        m_station_manager.post(Msg::SearchBackspace{});
+        break;
+    default:
+        // Printable ASCII and the raw bytes of UTF-8 characters.
+        if (ch >= ' ' && ch <= 0xFF) {
+            m_station_manager.post(Msg::SearchType{static_cast<char>(ch)});
         }
+        break;
     }
 }
@@ -2,6 +2,7 @@
 
 #include <mpv/client.h>
 
+#include <algorithm>
 #include <stdexcept>
 #include <utility>
 
@@ -15,10 +16,11 @@ namespace {
 RadioStream::RadioStream(int id, std::string name, std::vector<std::string> urls)
     : m_id(id), m_name(std::move(name)), m_urls(std::move(urls)), m_active_url_index(0), m_mpv_instance(),
       m_pending_mpv_instance(), m_is_initialized(false), m_generation(0), m_cycling_state(CyclingState::IDLE),
-      m_pending_title(""), m_pending_bitrate(0), m_cycle_start_time(std::nullopt), m_current_title("..."), m_bitrate(0),
+      m_pending_title(""), m_pending_bitrate(0), m_cycle_start_time(std::nullopt), m_pending_url_index(0),
+      m_race_start_time(std::nullopt), m_current_title("..."), m_bitrate(0),
       m_playback_state(PlaybackState::Playing), m_current_volume(0.0), m_pre_mute_volume(100.0), m_is_fading(false),
       m_target_volume(0.0), m_is_favorite(false), m_has_logged_first_song(false), m_is_buffering(false),
-      m_mute_start_time(std::nullopt), m_volume_offset(0.0) {}
+      m_mute_start_time(std::nullopt), m_volume_offset(0.0), m_is_unreachable(false) {}
 
 RadioStream::RadioStream(RadioStream&& other) noexcept
     : m_id(other.m_id), m_name(std::move(other.m_name)), m_urls(std::move(other.m_urls)),
@@ -27,12 +29,14 @@ RadioStream::RadioStream(RadioStream&& other) noexcept
       m_generation(other.m_generation), m_cycling_state(other.m_cycling_state),
       m_cycle_status_end_time(other.m_cycle_status_end_time), m_pending_title(std::move(other.m_pending_title)),
       m_pending_bitrate(other.m_pending_bitrate), m_cycle_start_time(std::move(other.m_cycle_start_time)),
-      m_current_title(std::move(other.m_current_title)), m_bitrate(other.m_bitrate),
-      m_playback_state(other.m_playback_state), m_current_volume(other.m_current_volume),
+      m_pending_url_index(other.m_pending_url_index), m_racers(std::move(other.m_racers)),
+      m_race_start_time(std::move(other.m_race_start_time)), m_current_title(std::move(other.m_current_title)),
+      m_bitrate(other.m_bitrate), m_playback_state(other.m_playback_state), m_current_volume(other.m_current_volume),
       m_pre_mute_volume(other.m_pre_mute_volume), m_is_fading(other.m_is_fading),
       m_target_volume(other.m_target_volume), m_is_favorite(other.m_is_favorite),
       m_has_logged_first_song(other.m_has_logged_first_song), m_is_buffering(other.m_is_buffering),
-      m_mute_start_time(std::move(other.m_mute_start_time)), m_volume_offset(other.m_volume_offset) {}
+      m_mute_start_time(std::move(other.m_mute_start_time)), m_volume_offset(other.m_volume_offset),
+      m_is_unreachable(other.m_is_unreachable) {}
 
 RadioStream& RadioStream::operator=(RadioStream&& other) noexcept {
     if (this != &other) {
@@ -49,6 +53,9 @@ RadioStream& RadioStream::operator=(RadioStream&& other) noexcept {
         m_pending_title = std::move(other.m_pending_title);
         m_pending_bitrate = other.m_pending_bitrate;
         m_cycle_start_time = std::move(other.m_cycle_start_time);
+        m_pending_url_index = other.m_pending_url_index;
+        m_racers = std::move(other.m_racers);
+        m_race_start_time = std::move(other.m_race_start_time);
         m_current_title = std::move(other.m_current_title);
         m_bitrate = other.m_bitrate;
         m_playback_state = other.m_playback_state;
@@ -61,6 +68,7 @@ RadioStream& RadioStream::operator=(RadioStream&& other) noexcept {
         m_is_buffering = other.m_is_buffering;
         m_mute_start_time = std::move(other.m_mute_start_time);
         m_volume_offset = other.m_volume_offset;
+        m_is_unreachable = other.m_is_unreachable;
     }
     return *this;
 }
@@ -69,6 +77,7 @@ void RadioStream::shutdown() {
     if (!m_is_initialized)
         return;
     m_generation++;
+    endRace();
     m_mpv_instance.shutdown();
     m_pending_mpv_instance.shutdown();
     m_is_initialized = false;
@@ -92,10 +101,11 @@ void RadioStream::initialize(double initial_volume) {
     if (!mpv)
         throw std::runtime_error("MpvInstance failed to provide a valid handle for " + m_name);
 
-    check_mpv_error(mpv_observe_property(mpv, m_id, "media-title", MPV_FORMAT_STRING), "observe media-title");
-    check_mpv_error(mpv_observe_property(mpv, m_id, "audio-bitrate", MPV_FORMAT_INT64), "observe audio-bitrate");
-    check_mpv_error(mpv_observe_property(mpv, m_id, "eof-reached", MPV_FORMAT_FLAG), "observe eof-reached");
-    check_mpv_error(mpv_observe_property(mpv, m_id, "core-idle", MPV_FORMAT_FLAG), "observe core-idle");
+    check_mpv_error(mpv_observe_property(mpv, MAIN_REPLY_ID, "media-title", MPV_FORMAT_STRING), "observe media-title");
+    check_mpv_error(mpv_observe_property(mpv, MAIN_REPLY_ID, "audio-bitrate", MPV_FORMAT_INT64),
+                    "observe audio-bitrate");
+    check_mpv_error(mpv_observe_property(mpv, MAIN_REPLY_ID, "eof-reached", MPV_FORMAT_FLAG), "observe eof-reached");
+    check_mpv_error(mpv_observe_property(mpv, MAIN_REPLY_ID, "core-idle", MPV_FORMAT_FLAG), "observe core-idle");
 
     const char* cmd[] = {"loadfile", getActiveUrl().c_str(), "replace", nullptr};
     check_mpv_error(mpv_command_async(mpv, 0, cmd), "loadfile for " + m_name);
@@ -115,11 +125,12 @@ void RadioStream::startCycle() {
     m_pending_title = "";
     m_pending_bitrate = 0;
     m_cycle_start_time = std::chrono::steady_clock::now();
+    m_pending_url_index = (m_active_url_index + 1) % m_urls.size();
 }
 
 void RadioStream::finalizeCycle(bool success) {
     if (success) {
-        m_active_url_index = (m_active_url_index + 1) % m_urls.size();
+        m_active_url_index = m_pending_url_index;
         m_cycling_state = CyclingState::SUCCEEDED;
     } else {
         m_cycling_state = CyclingState::FAILED;
@@ -150,22 +161,84 @@ void RadioStream::promotePendingToActive() {
     m_generation++;
 }
 
+void RadioStream::startRace(size_t racer_count) {
+    if (!m_is_initialized || !m_racers.empty())
+        return;
+    racer_count = std::min(racer_count, m_urls.size() - 1);
+    for (size_t i = 1; i <= racer_count; ++i) {
+        Racer racer{MpvInstance(), (m_active_url_index + i) % m_urls.size(), ""};
+        const std::string& url = m_urls[racer.url_index];
+        racer.instance.initialize(url);
+        mpv_handle* mpv = racer.instance.get();
+
+        double muted = 0.0;
+        check_mpv_error(mpv_set_property(mpv, "volume", MPV_FORMAT_DOUBLE, &muted), "mute racer");
+        check_mpv_error(mpv_observe_property(mpv, PENDING_REPLY_ID, "media-title", MPV_FORMAT_STRING),
+                        "observe racer media-title");
+        check_mpv_error(mpv_observe_property(mpv, PENDING_REPLY_ID, "audio-bitrate", MPV_FORMAT_INT64),
+                        "observe racer audio-bitrate");
+        const char* cmd[] = {"loadfile", url.c_str(), "replace", nullptr};
+        check_mpv_error(mpv_command_async(mpv, 0, cmd), "loadfile for racer of " + m_name);
+        m_racers.push_back(std::move(racer));
+    }
+    if (!m_racers.empty()) {
+        m_race_start_time = std::chrono::steady_clock::now();
+    }
+}
+
+void RadioStream::endRace() {
+    m_racers.clear(); // Each MpvInstance hangs up as it is destroyed
+    m_race_start_time = std::nullopt;
+}
+
+bool RadioStream::isRacing() const { return !m_racers.empty(); }
+size_t RadioStream::getRacerCount() const { return m_racers.size(); }
+mpv_handle* RadioStream::getRacerHandle(size_t racer) const { return m_racers[racer].instance.get(); }
+void RadioStream::setRacerTitle(size_t racer, const std::string& title) { m_racers[racer].title = title; }
+
+void RadioStream::dropRacer(size_t racer) {
+    m_racers.erase(m_racers.begin() + racer);
+    if (m_racers.empty()) {
+        m_race_start_time = std::nullopt;
+    }
+}
+
+void RadioStream::promoteRacer(size_t racer) {
+    Racer winner = std::move(m_racers[racer]);
+    endRace();
+    startCycle();
+    m_pending_mpv_instance = std::move(winner.instance);
+    m_pending_url_index = winner.url_index;
+    m_pending_title = winner.title;
+}
+
+std::optional<std::chrono::steady_clock::time_point> RadioStream::getRaceStartTime() const {
+    return m_race_start_time;
+}
+
 CyclingState RadioStream::getCyclingState() const { return m_cycling_state; }
 int RadioStream::getPendingBitrate() const { return m_pending_bitrate; }
 std::optional<std::chrono::steady_clock::time_point> RadioStream::getCycleStartTime() const {
     return m_cycle_start_time;
 }
 std::chrono::steady_clock::time_point RadioStream::getCycleStatusEndTime() const { return m_cycle_status_end_time; }
-const std::string& RadioStream::getNextUrl() const { return m_urls[(m_active_url_index + 1) % m_urls.size()]; }
+const std::string& RadioStream::getNextUrl() const { return m_urls[m_pending_url_index]; }
 MpvInstance& RadioStream::getPendingMpvInstance() { return m_pending_mpv_instance; }
 const std::string& RadioStream::getPendingTitle() const { return m_pending_title; }
 
 bool RadioStream::isInitialized() const { return m_is_initialized; }
 int RadioStream::getGeneration() const { return m_generation; }
 int RadioStream::getID() const { return m_id; }
+void RadioStream::setID(int id) { m_id = id; }
 const std::string& RadioStream::getName() const { return m_name; }
 const std::string& RadioStream::getActiveUrl() const { return m_urls[m_active_url_index]; }
 const std::vector<std::string>& RadioStream::getAllUrls() const { return m_urls; }
+void RadioStream::setUrlOrder(std::vector<std::string> urls) {
+    if (m_is_initialized || m_cycling_state != CyclingState::IDLE || urls.empty())
+        return;
+    m_urls = std::move(urls);
+    m_active_url_index = 0;
+}
 size_t RadioStream::getActiveUrlIndex() const { return m_active_url_index; }
 mpv_handle* RadioStream::getMpvHandle() const { return m_mpv_instance.get(); }
 std::string RadioStream::getCurrentTitle() const { return m_current_title; }
@@ -193,3 +266,6 @@ void RadioStream::setMuteStartTime() { m_mute_start_time = std::chrono::steady_c
 void RadioStream::resetMuteStartTime() { m_mute_start_time = std::nullopt; }
 double RadioStream::getVolumeOffset() const { return m_volume_offset; }
 void RadioStream::setVolumeOffset(double offset) { m_volume_offset = offset; }
+
+bool RadioStream::isUnreachable() const { return m_is_unreachable; }
+void RadioStream::setUnreachable(bool unreachable) { m_is_unreachable = unreachable; }
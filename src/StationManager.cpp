@@ -4,15 +4,26 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstdlib>
+#include <future>
 #include <ctime>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <numeric>
 #include <sstream>
 #include <stdexcept>
 
 #include "Core/ActionHandler.h"
+#include "Core/HistorySearchIndex.h"
+#include "Core/Metrics.h"
 #include "Core/MpvEventHandler.h"
+#include "Core/PersistenceWorker.h"
+#include "Core/RandomStationQueue.h"
+#include "Core/ReconnectScheduler.h"
+#include "Core/SeenStationFilter.h"
+#include "Core/StationHealthProber.h"
+#include "Core/StationSearchIndex.h"
 #include "Core/SystemHandler.h"
 #include "Core/UpdateManager.h"
 #include "Core/VolumeNormalizer.h"
@@ -23,16 +34,97 @@
 namespace {
     constexpr auto ACTOR_LOOP_TIMEOUT = std::chrono::milliseconds(20);
     constexpr int CROSSFADE_TIME_MS = 1200;
+    constexpr size_t RANDOM_STATIONS_TARGET_COUNT = 15; // Stations added to the list at a time
+    // Random mode trims its list back to this many stations once it grows past it,
+    // always keeping at least RANDOM_WINDOW_BEHIND stations above the cursor.
+    constexpr int RANDOM_WINDOW_STATIONS = 150;
+    constexpr int RANDOM_WINDOW_BEHIND = 50;
+    // Upper bound on history rows copied into a snapshot; no terminal is taller than this.
+    constexpr int HISTORY_SNAPSHOT_ROWS = 200;
+    // Station rows assumed visible until the UI reports its real viewport.
+    constexpr int DEFAULT_VIEWPORT_ROWS = 64;
+    constexpr const char* NAV_SETTLE_ENV_VAR = "STREAM_HOPPER_NAV_SETTLE_MS";
+    constexpr int DEFAULT_NAV_SETTLE_MS = 150;
+    constexpr int MAX_NAV_SETTLE_MS = 2000;
+    // How many of its URLs a station opens at once when it starts under the cursor.
+    constexpr const char* URL_RACE_ENV_VAR = "STREAM_HOPPER_URL_RACE";
+    constexpr int MAX_URL_RACE = 4;
     const std::string SEARCH_PROVIDERS_FILENAME = "search_providers.jsonc";
+
+    StationDisplayData make_display_data(const RadioStream& station, const ReconnectStatus& reconnect) {
+        // FIX: Replaced C++20 designated initializers with C++17 aggregate initialization
+        return {station.getName(),          station.getCurrentTitle(),   station.getBitrate(),
+                station.getCurrentVolume(), station.isInitialized(),     station.isFavorite(),
+                station.isBuffering(),      station.getPlaybackState(),  station.getCyclingState(),
+                station.getPendingTitle(),  station.getPendingBitrate(), station.getAllUrls().size(),
+                station.getVolumeOffset(),  station.isUnreachable(),     reconnect.state,
+                reconnect.total_failures};
+    }
+
+    std::chrono::milliseconds nav_settle_delay_from_environment() {
+        int delay_ms = DEFAULT_NAV_SETTLE_MS;
+        if (const char* value = getenv(NAV_SETTLE_ENV_VAR)) {
+            delay_ms = std::clamp(std::atoi(value), 0, MAX_NAV_SETTLE_MS); // 0 commits every jump
+        }
+        return std::chrono::milliseconds(delay_ms);
+    }
+
+    int url_race_from_environment() {
+        int urls = 1; // Off: only the first URL is opened
+        if (const char* value = getenv(URL_RACE_ENV_VAR)) {
+            urls = std::clamp(std::atoi(value), 1, MAX_URL_RACE);
+        }
+        return urls;
+    }
+
+    // A loader that failed outright (e.g. an unreadable file) must not take the
+    // actor down with it; the session carries on with nothing loaded.
+    template <typename T> T take_startup_result(std::future<T>& result, const char* what) {
+        try {
+            return result.get();
+        } catch (const std::exception&) {
+            Metrics::increment(std::string("startup.load_failed.") + what);
+            return T{};
+        }
+    }
+
+    // Folds each run of consecutive NavigateUp/NavigateDown into one NavigateBy,
+    // so a held arrow key costs one jump per batch rather than one per repeat.
+    void coalesce_navigation(std::deque<StationManagerMessage>& queue) {
+        std::deque<StationManagerMessage> coalesced;
+        long folded = 0;
+        for (auto& msg : queue) {
+            int step = std::holds_alternative<Msg::NavigateUp>(msg)     ? -1
+                       : std::holds_alternative<Msg::NavigateDown>(msg) ? 1
+                                                                        : 0;
+            if (step == 0) {
+                coalesced.push_back(std::move(msg));
+                continue;
+            }
+            if (!coalesced.empty()) {
+                if (auto* previous = std::get_if<Msg::NavigateBy>(&coalesced.back())) {
+                    previous->steps += step;
+                    ++folded;
+                    continue;
+                }
+            }
+            coalesced.push_back(Msg::NavigateBy{step});
+        }
+        queue.swap(coalesced);
+        if (folded > 0) {
+            Metrics::increment("actor.navigation_coalesced", folded);
+        }
+    }
 }
 
-void StationManager::loadSearchProviders() {
+std::map<char, SearchProvider> StationManager::loadSearchProviders() {
+    std::map<char, SearchProvider> search_providers;
     std::ifstream i(SEARCH_PROVIDERS_FILENAME);
     if (!i.is_open()) {
         // Log an error but don't crash, the feature will just be disabled
         std::cerr << "Warning: Could not open " << SEARCH_PROVIDERS_FILENAME << ". Search feature will be disabled."
                   << std::endl;
-        return;
+        return search_providers;
     }
 
     try {
@@ -53,49 +145,45 @@ void StationManager::loadSearchProviders() {
                 // FIX: Replaced C++20 designated initializers with C++17 aggregate initialization
                 SearchProvider p{entry.at("name").get<std::string>(), key_str[0],
                                  entry.at("base_url").get<std::string>(), style};
-                m_search_providers[p.key] = p;
+                search_providers[p.key] = p;
             }
         }
     } catch (const nlohmann::json::exception& e) {
         std::cerr << "Warning: Failed to parse " << SEARCH_PROVIDERS_FILENAME << ": " << e.what()
                   << ". Search feature may be incomplete." << std::endl;
     }
+    return search_providers;
 }
 
 StationManager::StationManager(const StationData& station_data)
-    : m_unsaved_history_count(0), m_is_fetching_random_stations(false), m_fetch_is_for_append(false),
-      m_session_state(), m_quit_flag(false), m_needs_redraw(true) {
+    : m_history_write_behind(std::make_shared<HistoryWriteBehind>()), m_is_fetching_random_stations(false),
+      m_fetch_is_for_append(false), m_session_state(), m_quit_flag(false), m_needs_redraw(true),
+      m_viewport_rows(DEFAULT_VIEWPORT_ROWS), m_nav_settle_delay(nav_settle_delay_from_environment()),
+      m_url_race(url_race_from_environment()) {
     if (station_data.empty()) {
         throw std::runtime_error("No radio stations provided.");
     }
 
-    loadSearchProviders(); // Load the new config
+    m_persistence_worker = std::make_unique<PersistenceWorker>();
+    m_reconnect_scheduler = std::make_unique<ReconnectScheduler>();
+    m_random_station_queue = std::make_unique<RandomStationQueue>();
+    m_health_prober = std::make_unique<StationHealthProber>();
 
+    m_station_search_index = std::make_unique<StationSearchIndex>();
     for (size_t i = 0; i < station_data.size(); ++i) {
-        m_stations.emplace_back(i, station_data[i].first, station_data[i].second);
+        m_stations.emplace_back(i, station_data[i].name, station_data[i].urls);
+        m_station_search_index->add(i, station_data[i].name, station_data[i].tags);
     }
-
+    m_song_history = std::make_unique<SongHistory>();
+    m_history_search_index = std::make_unique<HistorySearchIndex>();
+
+    // Startup is staged so the first audio arrives as early as possible:
+    //   1. Only the tiny session file is read here, to find the last-played station.
+    //   2. The actor starts connecting that station before anything else.
+    //   3. History, favorites, volume offsets and search providers load in
+    //      parallel and are merged in by UpdateManager once they are ready.
+    //   4. The rest of the preload window fills in after first audio.
     PersistenceManager persistence;
-    m_song_history = std::make_unique<nlohmann::json>(persistence.loadHistory());
-    if (!m_song_history->is_object()) {
-        *m_song_history = nlohmann::json::object();
-    }
-
-    const auto favorite_names = persistence.loadFavoriteNames();
-    const auto volume_offsets = persistence.loadVolumeOffsets();
-
-    for (auto& station : m_stations) {
-        if (favorite_names.count(station.getName())) {
-            station.toggleFavorite();
-        }
-        if (volume_offsets.count(station.getName())) {
-            station.setVolumeOffset(volume_offsets.at(station.getName()));
-        }
-        if (!m_song_history->contains(station.getName())) {
-            (*m_song_history)[station.getName()] = nlohmann::json::array();
-        }
-    }
-
     if (auto last_station_name = persistence.loadLastStationName()) {
         auto it = std::find_if(m_stations.begin(), m_stations.end(),
                                [&](const RadioStream& station) { return station.getName() == *last_station_name; });
@@ -104,6 +192,15 @@ StationManager::StationManager(const StationData& station_data)
         }
     }
 
+    m_startup_load.history = std::async(std::launch::async, [] { return PersistenceManager().loadHistory(); });
+    m_startup_load.favorite_names =
+        std::async(std::launch::async, [] { return PersistenceManager().loadFavoriteNames(); });
+    m_startup_load.volume_offsets =
+        std::async(std::launch::async, [] { return PersistenceManager().loadVolumeOffsets(); });
+    m_startup_load.search_providers = std::async(std::launch::async, [] { return loadSearchProviders(); });
+    watchStationUrls();
+    Metrics::recordDuration("startup.stations_ready", Metrics::msSinceProcessStart());
+
     m_event_handler = std::make_unique<MpvEventHandler>(*this);
     m_action_handler = std::make_unique<ActionHandler>();
     m_system_handler = std::make_unique<SystemHandler>();
@@ -117,15 +214,23 @@ StationManager::~StationManager() {
     if (m_actor_thread.joinable()) {
         m_actor_thread.join();
     }
-    PersistenceManager persistence;
-    persistence.saveHistory(*m_song_history);
-    persistence.saveFavorites(m_stations);
+    // Never save over files we have not finished reading.
+    applyStartupData();
+    saveHistoryToDisk();
+    saveFavoritesToDisk();
     saveVolumeOffsetsToDisk(); // Save any pending volume changes
     if (m_session_state.app_mode == AppMode::CURATED && !m_stations.empty() &&
         m_session_state.active_station_idx >= 0 &&
         m_session_state.active_station_idx < (int) m_stations.size()) {
-        persistence.saveSession(m_stations[m_session_state.active_station_idx].getName());
+        std::string last_station_name = m_stations[m_session_state.active_station_idx].getName();
+        m_persistence_worker->submit("session", [last_station_name]() {
+            PersistenceManager persistence;
+            persistence.saveSession(last_station_name);
+        });
     }
+    m_persistence_worker->flush();
+    Metrics::increment("ui.redraw_requests", m_redraw_requests.load());
+    Metrics::writeReportIfEnabled();
     if (m_session_state.was_quit_by_mute_timeout) {
         constexpr int FORGOTTEN_MUTE_SECONDS = 600;
         std::cout << "Hey, you forgot about me for " << (FORGOTTEN_MUTE_SECONDS / 60) << " minutes! 😤" << std::endl;
@@ -147,11 +252,69 @@ StationManager::~StationManager() {
 void StationManager::appendStations(const StationData& station_data) {
     size_t current_size = m_stations.size();
     for (size_t i = 0; i < station_data.size(); ++i) {
-        m_stations.emplace_back(current_size + i, station_data[i].first, station_data[i].second);
+        m_stations.emplace_back(current_size + i, station_data[i].name, station_data[i].urls);
+        m_station_search_index->add(current_size + i, station_data[i].name, station_data[i].tags);
     }
+    trimRandomWindow();
+    watchStationUrls();
     // No need to reset state, just update the active window if needed
     updateActiveWindow();
-    m_needs_redraw = true;
+    requestRedraw();
+}
+
+void StationManager::trimRandomWindow() {
+    if (m_session_state.app_mode != AppMode::RANDOM)
+        return;
+    int evict = std::min((int) m_stations.size() - RANDOM_WINDOW_STATIONS,
+                         m_session_state.active_station_idx - RANDOM_WINDOW_BEHIND);
+    // Stations still loaded, fading or kept warm by the finder stay.
+    for (int idx : m_active_station_indices)
+        evict = std::min(evict, idx);
+    for (const auto& fade : m_active_fades)
+        evict = std::min(evict, fade.station_id);
+    for (int idx : m_session_state.warm_station_indices)
+        evict = std::min(evict, idx);
+    if (evict <= 0)
+        return;
+
+    for (int i = 0; i < evict; ++i) {
+        const RadioStream& station = m_stations.front();
+        if (station.isFavorite()) {
+            m_archived_favorites.insert(station.getName());
+        }
+        if (std::abs(station.getVolumeOffset()) > 0.01) {
+            m_archived_volume_offsets[station.getName()] = station.getVolumeOffset();
+        }
+        m_stations.pop_front();
+    }
+
+    // Station ids are list indices, so everything that holds one moves up by `evict`.
+    for (auto& station : m_stations) {
+        station.setID(station.getID() - evict);
+    }
+    std::unordered_set<int> active_indices;
+    for (int idx : m_active_station_indices) {
+        active_indices.insert(idx - evict);
+    }
+    m_active_station_indices.swap(active_indices);
+    for (auto& fade : m_active_fades) {
+        fade.station_id -= evict;
+    }
+    for (int& idx : m_session_state.warm_station_indices) {
+        idx -= evict;
+    }
+    auto& results = m_session_state.station_search_results;
+    results.erase(std::remove_if(results.begin(), results.end(), [evict](int idx) { return idx < evict; }),
+                  results.end());
+    for (int& idx : results) {
+        idx -= evict;
+    }
+    m_session_state.search_selected =
+        std::clamp(m_session_state.search_selected, 0, std::max(0, (int) results.size() - 1));
+    m_session_state.active_station_idx -= evict;
+    m_station_search_index->dropFront(evict);
+    m_reconnect_scheduler->dropFront(evict);
+    Metrics::increment("random.stations_trimmed", evict);
 }
 
 void StationManager::resetWithNewStations(const StationData& station_data) {
@@ -163,11 +326,14 @@ void StationManager::resetWithNewStations(const StationData& station_data) {
     }
     m_active_station_indices.clear();
     m_active_fades.clear();
+    m_reconnect_scheduler->clear();
 
     // 2. Replace the station list
     m_stations.clear();
+    m_station_search_index->clear();
     for (size_t i = 0; i < station_data.size(); ++i) {
-        m_stations.emplace_back(i, station_data[i].first, station_data[i].second);
+        m_stations.emplace_back(i, station_data[i].name, station_data[i].urls);
+        m_station_search_index->add(i, station_data[i].name, station_data[i].tags);
     }
 
     // 3. Reset session and UI state
@@ -175,10 +341,49 @@ void StationManager::resetWithNewStations(const StationData& station_data) {
     m_session_state.history_scroll_offset = 0;
     m_session_state.active_panel = ActivePanel::STATIONS;
     m_session_state.nav_history.clear();
+    m_session_state.search_active = false;
+    m_session_state.station_search_results.clear();
+    m_session_state.warm_station_indices.clear();
 
     // 4. Initialize the new set of stations
+    watchStationUrls();
     updateActiveWindow();
-    m_needs_redraw = true;
+    requestRedraw();
+}
+
+void StationManager::watchStationUrls() {
+    std::vector<int> order(m_stations.size());
+    std::iota(order.begin(), order.end(), 0);
+    const int cursor = m_session_state.active_station_idx;
+    std::stable_sort(order.begin(), order.end(),
+                     [cursor](int a, int b) { return std::abs(a - cursor) < std::abs(b - cursor); });
+    std::vector<std::string> urls;
+    for (int idx : order) {
+        const auto& station_urls = m_stations[idx].getAllUrls();
+        urls.insert(urls.end(), station_urls.begin(), station_urls.end());
+    }
+    m_health_prober->setUrls(std::move(urls));
+}
+
+bool StationManager::takeRandomStations(bool append) {
+    auto stations = m_random_station_queue->take(RANDOM_STATIONS_TARGET_COUNT);
+    if (stations.empty()) {
+        return false;
+    }
+    StationData station_data;
+    for (const auto& s : stations) {
+        station_data.push_back({s.name, s.urls, s.tags});
+    }
+    if (append) {
+        appendStations(station_data);
+    } else {
+        resetWithNewStations(station_data);
+    }
+    m_persistence_worker->submit("seen_stations", [seen = m_random_station_queue->seenStations()]() {
+        PersistenceManager persistence;
+        persistence.saveSeenStations(seen);
+    });
+    return true;
 }
 
 StateSnapshot StationManager::createSnapshot() const {
@@ -194,29 +399,51 @@ StateSnapshot StationManager::createSnapshot() const {
     snapshot.temporary_status_message = m_session_state.temporary_status_message;
     snapshot.is_volume_offset_mode_active = m_volume_normalizer->isUiActive();
     snapshot.is_fetching_stations = m_is_fetching_random_stations;
-    snapshot.stations.reserve(m_stations.size());
-    for (const auto& station : m_stations) {
-        // FIX: Replaced C++20 designated initializers with C++17 aggregate initialization
-        snapshot.stations.push_back({station.getName(), station.getCurrentTitle(), station.getBitrate(),
-                                     station.getCurrentVolume(), station.isInitialized(), station.isFavorite(),
-                                     station.isBuffering(), station.getPlaybackState(), station.getCyclingState(),
-                                     station.getPendingTitle(), station.getPendingBitrate(),
-                                     station.getAllUrls().size(), station.getVolumeOffset()});
+    snapshot.total_station_count = static_cast<int>(m_stations.size());
+
+    // The list panel keeps the active station within one viewport of its scroll
+    // offset, so a window of that size on either side covers every visible row.
+    const int viewport = m_viewport_rows.load();
+    const int active = std::clamp(m_session_state.active_station_idx, 0, std::max(0, snapshot.total_station_count - 1));
+    const int window_begin = std::max(0, active - viewport);
+    const int window_end = std::min(snapshot.total_station_count, active + viewport + 1);
+    snapshot.station_window_start = window_begin;
+    snapshot.stations.reserve(std::max(0, window_end - window_begin));
+    for (int i = window_begin; i < window_end; ++i) {
+        snapshot.stations.push_back(make_display_data(m_stations[i], m_reconnect_scheduler->status(i)));
+    }
+
+    snapshot.is_search_active = m_session_state.search_active;
+    snapshot.search_requests_handled = m_session_state.search_requests_handled;
+    if (snapshot.is_search_active) {
+        snapshot.search_scope = m_session_state.search_scope;
+        snapshot.search_query = m_session_state.search_query;
+        snapshot.search_selected = m_session_state.search_selected;
+        for (int idx : m_session_state.station_search_results) {
+            if (idx >= 0 && idx < snapshot.total_station_count) {
+                snapshot.station_search_results.push_back(
+                    {idx, make_display_data(m_stations[idx], m_reconnect_scheduler->status(idx))});
+            }
+        }
+        HistoryTimeFormatter formatter;
+        const std::time_t today_start = formatter.todayStart(std::time(nullptr));
+        for (const auto& hit : m_session_state.history_search_results) {
+            HistorySearchRow row{{}, m_history_search_index->stationName(hit.station_id),
+                                 m_song_history->title(hit.title_id)};
+            formatter.format(hit.timestamp, today_start, row.time_label);
+            snapshot.history_search_results.push_back(std::move(row));
+        }
     }
     snapshot.current_volume_for_header = 0.0;
-    if (!m_stations.empty() && m_session_state.active_station_idx >= 0 &&
-        m_session_state.active_station_idx < (int) m_stations.size()) {
-        const auto& active_station_data = snapshot.stations[snapshot.active_station_idx];
+    if (const StationDisplayData* active_station = snapshot.activeStation()) {
+        const auto& active_station_data = *active_station;
         if (active_station_data.is_initialized) {
             snapshot.current_volume_for_header =
                 active_station_data.playback_state == PlaybackState::Muted ? 0.0 : active_station_data.current_volume;
         }
-        const auto& active_station_name = active_station_data.name;
-        if (m_song_history->contains(active_station_name)) {
-            snapshot.active_station_history = (*m_song_history)[active_station_name];
-        } else {
-            snapshot.active_station_history = nlohmann::json::array();
-        }
+        m_song_history->collectRows(active_station_data.name, m_session_state.history_scroll_offset,
+                                    HISTORY_SNAPSHOT_ROWS, std::time(nullptr), snapshot.active_station_history);
+        snapshot.history_titles = m_song_history->titleStorage();
     } else {
         snapshot.active_station_idx = -1; // Indicate no active station
     }
@@ -245,10 +472,41 @@ void StationManager::post(StationManagerMessage message) {
 }
 
 std::atomic<bool>& StationManager::getQuitFlag() { return m_quit_flag; }
-std::atomic<bool>& StationManager::getNeedsRedrawFlag() { return m_needs_redraw; }
+
+void StationManager::requestRedraw() {
+    m_redraw_requests.fetch_add(1, std::memory_order_relaxed);
+    // Only the first request of a burst needs to wake the UI.
+    if (!m_needs_redraw.exchange(true)) {
+        m_ui_wakeup.notify();
+    }
+}
+
+bool StationManager::takeRedrawRequest() {
+    // Drained first, so a request racing with this call still leaves the fd readable.
+    m_ui_wakeup.drain();
+    return m_needs_redraw.exchange(false);
+}
+
+int StationManager::getUiWakeupFd() const { return m_ui_wakeup.fd(); }
+
+void StationManager::setAnimationsEnabled(bool enabled) { m_animations_enabled = enabled; }
+
+void StationManager::setViewportRows(int rows) {
+    rows = std::max(1, rows);
+    // A taller list than the last snapshot covered needs a fresh snapshot.
+    if (m_viewport_rows.exchange(rows) < rows) {
+        requestRedraw();
+    }
+}
 
 void StationManager::actorLoop() {
-    updateActiveWindow();
+    {
+        // Audio first: connect the last-played station before anything else.
+        std::lock_guard<std::mutex> lock(m_stations_mutex);
+        m_startup_stage_start = std::chrono::steady_clock::now();
+        initializeStation(m_session_state.active_station_idx);
+    }
+    auto last_tick = std::chrono::steady_clock::now();
     while (!m_quit_flag) {
         std::deque<StationManagerMessage> current_queue;
         {
@@ -260,9 +518,13 @@ void StationManager::actorLoop() {
         }
         if (m_quit_flag)
             break;
+        coalesce_navigation(current_queue);
         std::lock_guard<std::mutex> lock(m_stations_mutex);
-        if (current_queue.empty()) {
+        // The actor drives its own timers and mpv polling, even through a burst of input.
+        auto now = std::chrono::steady_clock::now();
+        if (current_queue.empty() || now - last_tick >= ACTOR_LOOP_TIMEOUT) {
             current_queue.push_back(Msg::UpdateAndPoll{});
+            last_tick = now;
         }
         for (auto& msg : current_queue) {
             if (std::holds_alternative<Msg::UpdateAndPoll>(msg) || std::holds_alternative<Msg::Quit>(msg) ||
@@ -302,9 +564,18 @@ void StationManager::pollMpvEvents() {
                 continue;
             mpv_event* event = mpv_wait_event(m_stations[station_idx].getMpvHandle(), 0);
             if (event->event_id != MPV_EVENT_NONE) {
-                m_event_handler->handleEvent(event);
+                m_event_handler->handleEvent(m_stations[station_idx], event, false);
                 events_pending = true;
             }
+            RadioStream& station = m_stations[station_idx];
+            for (size_t racer = 0; racer < station.getRacerCount(); ++racer) {
+                mpv_event* racer_event = mpv_wait_event(station.getRacerHandle(racer), 0);
+                if (racer_event->event_id != MPV_EVENT_NONE) {
+                    m_event_handler->handleRacerEvent(station, racer, racer_event);
+                    events_pending = true;
+                    break; // The handler may have dropped or promoted racers
+                }
+            }
         }
 
         if (m_session_state.active_station_idx >= 0 && m_session_state.active_station_idx < (int) m_stations.size()) {
@@ -312,7 +583,7 @@ void StationManager::pollMpvEvents() {
             if (station.getCyclingState() == CyclingState::CYCLING && station.getPendingMpvInstance().get()) {
                 mpv_event* event = mpv_wait_event(station.getPendingMpvInstance().get(), 0);
                 if (event->event_id != MPV_EVENT_NONE) {
-                    m_event_handler->handleEvent(event);
+                    m_event_handler->handleEvent(station, event, true);
                     events_pending = true;
                 }
             }
@@ -331,10 +602,12 @@ void StationManager::applyCombinedVolume(int station_id, bool for_pending) {
 
     double base_volume = for_pending ? 0.0 : station.getCurrentVolume();
     double offset = for_pending ? 0.0 : station.getVolumeOffset(); // No offset on pending streams
-    double final_volume = std::clamp(base_volume + offset, 0.0, 150.0);
+    // The offset is a gain, so it scales with the base: a muted preload stays silent
+    // and full volume gets the whole offset.
+    double final_volume = std::clamp(base_volume * (1.0 + offset / 100.0), 0.0, 150.0);
 
     mpv_set_property_async(handle, 0, "volume", MPV_FORMAT_DOUBLE, &final_volume);
-    m_needs_redraw = true;
+    requestRedraw();
 }
 
 void StationManager::fadeAudio(int station_id, double to_vol, int duration_ms, bool for_pending) {
@@ -359,6 +632,7 @@ void StationManager::fadeAudio(int station_id, double to_vol, int duration_ms, b
 }
 
 void StationManager::updateActiveWindow() {
+    m_session_state.window_commit_deadline.reset();
     if (m_stations.empty()) {
         // If the list is empty (e.g., during a fetch), shutdown everything.
         std::vector<int> to_shutdown(m_active_station_indices.begin(), m_active_station_indices.end());
@@ -370,7 +644,9 @@ void StationManager::updateActiveWindow() {
 
     const auto new_active_set =
         m_preloader.calculate_active_indices(m_session_state.active_station_idx, m_stations.size(),
-                                             m_session_state.hopper_mode, m_session_state.nav_history);
+                                             m_session_state.app_mode != AppMode::RANDOM,
+                                             m_session_state.hopper_mode, m_session_state.nav_history,
+                                             m_session_state.warm_station_indices);
     std::vector<int> to_shutdown;
     for (int idx : m_active_station_indices) {
         if (new_active_set.find(idx) == new_active_set.end()) {
@@ -398,10 +674,19 @@ void StationManager::updateActiveWindow() {
 void StationManager::initializeStation(int station_idx) {
     if (station_idx < 0 || station_idx >= (int) m_stations.size())
         return;
-    double vol = (station_idx == m_session_state.active_station_idx) ? 100.0 : 0.0;
-    m_stations[station_idx].initialize(vol);
+    RadioStream& station = m_stations[station_idx];
+    const bool is_active = station_idx == m_session_state.active_station_idx;
+    const bool was_initialized = station.isInitialized();
+    station.initialize(is_active ? 100.0 : 0.0);
     applyCombinedVolume(station_idx);
     m_active_station_indices.insert(station_idx);
+    // The station being waited on also tries its next URLs, in case the first is slow.
+    if (is_active && !was_initialized && m_url_race > 1) {
+        station.startRace(m_url_race - 1);
+        if (station.isRacing()) {
+            Metrics::increment("race.started");
+        }
+    }
 }
 
 void StationManager::shutdownStation(int station_idx) {
@@ -409,38 +694,138 @@ void StationManager::shutdownStation(int station_idx) {
         return;
     m_stations[station_idx].shutdown();
     m_active_station_indices.erase(station_idx);
+    m_reconnect_scheduler->forget(station_idx);
+}
+
+bool StationManager::isStartupDataReady() const {
+    auto is_ready = [](const auto& future) {
+        return future.valid() && future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    };
+    return is_ready(m_startup_load.history) && is_ready(m_startup_load.favorite_names) &&
+           is_ready(m_startup_load.volume_offsets) && is_ready(m_startup_load.search_providers);
 }
 
+void StationManager::applyStartupData() {
+    if (m_startup_data_applied)
+        return;
+    m_startup_data_applied = true;
+
+    // Songs logged while the file was still loading are kept on top of it.
+    SongHistory loaded_history = take_startup_result(m_startup_load.history, "history");
+    for (const auto& [station_name, entries] : m_song_history->stations()) {
+        for (const auto& entry : entries) {
+            loaded_history.add(station_name, entry.timestamp, m_song_history->title(entry.title_id));
+        }
+    }
+    *m_song_history = std::move(loaded_history);
+    m_history_search_index->rebuild(*m_song_history);
+
+    const auto favorite_names = take_startup_result(m_startup_load.favorite_names, "favorites");
+    const auto volume_offsets = take_startup_result(m_startup_load.volume_offsets, "volume_offsets");
+    for (auto& station : m_stations) {
+        if (favorite_names.count(station.getName()) && !station.isFavorite() &&
+            !m_favorites_toggled_early.count(station.getName())) {
+            station.toggleFavorite();
+        }
+        auto offset_it = volume_offsets.find(station.getName());
+        if (offset_it != volume_offsets.end() && std::abs(station.getVolumeOffset()) < 0.01) {
+            station.setVolumeOffset(offset_it->second);
+            if (station.isInitialized()) {
+                applyCombinedVolume(station.getID());
+            }
+        }
+    }
+    m_favorites_toggled_early.clear();
+    m_search_providers = take_startup_result(m_startup_load.search_providers, "search_providers");
+    Metrics::recordDuration("startup.persistence_ready", Metrics::msSinceProcessStart());
+    requestRedraw();
+}
+
+void StationManager::onFirstAudio() {
+    if (m_first_audio_recorded)
+        return;
+    m_first_audio_recorded = true;
+    Metrics::recordDuration("startup.first_audio", Metrics::msSinceProcessStart());
+}
+
+// The save helpers below run on the actor (or in the destructor after it has
+// stopped). They capture an immutable copy of the state and leave the actual
+// disk write to the persistence worker.
 void StationManager::saveHistoryToDisk() {
-    PersistenceManager persistence;
-    persistence.saveHistory(*m_song_history);
-    m_unsaved_history_count = 0;
+    if (!m_startup_data_applied || m_unsaved_songs.empty())
+        return;
+    {
+        std::lock_guard<std::mutex> lock(m_history_write_behind->mutex);
+        auto& pending = m_history_write_behind->pending;
+        pending.insert(pending.end(), std::make_move_iterator(m_unsaved_songs.begin()),
+                       std::make_move_iterator(m_unsaved_songs.end()));
+    }
+    m_unsaved_songs.clear();
+    // A coalesced job finds the songs of the job it replaced still pending.
+    m_persistence_worker->submit("history", [write_behind = m_history_write_behind]() {
+        std::vector<LoggedSong> songs;
+        {
+            std::lock_guard<std::mutex> lock(write_behind->mutex);
+            songs.swap(write_behind->pending);
+        }
+        PersistenceManager persistence;
+        if (!write_behind->history) {
+            write_behind->history = persistence.loadHistory(); // Nothing has written it since startup
+        }
+        for (const auto& song : songs) {
+            write_behind->history->add(song.station_name, song.timestamp, song.title);
+        }
+        persistence.saveHistory(*write_behind->history);
+        persistence.saveHistoryIndex(*write_behind->history);
+    });
+}
+
+void StationManager::saveFavoritesToDisk() {
+    if (!m_startup_data_applied)
+        return;
+    std::vector<std::string> favorite_names;
+    std::unordered_set<std::string> listed_names;
+    for (const auto& station : m_stations) {
+        listed_names.insert(station.getName());
+        if (station.isFavorite()) {
+            favorite_names.push_back(station.getName());
+        }
+    }
+    for (const auto& name : m_archived_favorites) {
+        if (!listed_names.count(name)) { // A station can come back into the list and be unfavorited
+            favorite_names.push_back(name);
+        }
+    }
+    m_persistence_worker->submit("favorites", [names = std::move(favorite_names)]() {
+        PersistenceManager persistence;
+        persistence.saveFavorites(names);
+    });
 }
 
 void StationManager::saveVolumeOffsetsToDisk() {
-    PersistenceManager persistence;
-    std::map<std::string, double> offsets;
+    if (!m_startup_data_applied)
+        return;
+    std::map<std::string, double> offsets = m_archived_volume_offsets;
     for (const auto& station : m_stations) {
+        offsets.erase(station.getName()); // The listed station's offset wins
         // Only save non-default values to keep the file clean
         if (std::abs(station.getVolumeOffset()) > 0.01) {
             offsets[station.getName()] = station.getVolumeOffset();
         }
     }
-    persistence.saveVolumeOffsets(offsets);
+    m_persistence_worker->submit("volume_offsets", [offsets = std::move(offsets)]() {
+        PersistenceManager persistence;
+        persistence.saveVolumeOffsets(offsets);
+    });
 }
 
-void StationManager::addHistoryEntry(const std::string& station_name, const nlohmann::json& entry) {
-    // FIX: This now robustly handles new stations and corrupted history entries.
-    if (m_song_history->contains(station_name) && (*m_song_history)[station_name].is_array()) {
-        (*m_song_history)[station_name].push_back(entry);
-    } else {
-        // If the key doesn't exist OR the value is corrupt (not an array),
-        // overwrite it with a new array containing the new entry.
-        (*m_song_history)[station_name] = nlohmann::json::array({entry});
-    }
+void StationManager::addHistoryEntry(const std::string& station_name, std::time_t timestamp, const std::string& title) {
+    std::uint32_t title_id = m_song_history->add(station_name, timestamp, title);
+    m_history_search_index->add(station_name, timestamp, title_id, title);
 
     m_session_state.new_songs_found++;
-    if (++m_unsaved_history_count >= HISTORY_WRITE_THRESHOLD) {
+    m_unsaved_songs.push_back({station_name, timestamp, title});
+    if ((int) m_unsaved_songs.size() >= HISTORY_WRITE_THRESHOLD) {
         saveHistoryToDisk();
     }
 }
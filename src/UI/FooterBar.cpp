@@ -11,6 +11,7 @@ void FooterBar::draw(AppMode app_mode,
                      bool is_copy_mode_active,
                      bool is_auto_hop_mode_active,
                      bool can_cycle_url,
+                     bool is_search_active,
                      const std::string& temp_msg) {
     std::string footer_text;
     std::string cycle_text = can_cycle_url ? "[+] Cycle " : "";
@@ -20,6 +21,8 @@ void FooterBar::draw(AppMode app_mode,
     if (!temp_msg.empty()) {
         footer_text = " " + temp_msg + " ";
         is_error_msg = true;
+    } else if (is_search_active) {
+        footer_text = " [FIND] Type to filter   [↑↓] Select   [↵] Play station   [Esc] Cancel ";
     } else if (is_copy_mode_active) {
         // This is now dynamically generated in the final version, but a static placeholder is fine for now
         // A more advanced version would get the provider list from the snapshot.
@@ -27,30 +30,37 @@ void FooterBar::draw(AppMode app_mode,
     } else if (is_auto_hop_mode_active) {
         footer_text = " [A] Stop Auto-Hop   [C] Search Online   [Q] Quit ";
     } else if (is_compact) {
-        footer_text = "[P] Mode [A] Auto [↑↓ Nav] " + cycle_text + random_text +
+        footer_text = "[P] Mode [A] Auto [↑↓ Nav] [/] Find [H] History " + cycle_text + random_text +
                       "[←→ Vol] [Tab] Panel [F] Fav [D] Duck [C] Search [Q] Quit ";
     } else {
-        footer_text = "[P] Mode [A] Auto-Hop [↑↓] Nav [←→] Station Vol [↵] Mute " + cycle_text + random_text +
-                      "[D] Duck [⇥] Panel [F] Fav [C] Search [Q] Quit ";
+        footer_text = "[P] Mode [A] Auto-Hop [↑↓] Nav [/] Find [H] Find Song [←→] Station Vol [↵] Mute " + cycle_text +
+                      random_text + "[D] Duck [⇥] Panel [F] Fav [C] Search [Q] Quit ";
     }
 
-    attron(A_REVERSE);
-    mvprintw(m_y, m_x, "%*s", m_w, "");
+    bool is_highlighted = is_copy_mode_active || is_error_msg;
+    if ((!m_dirty && footer_text == m_last_text && is_highlighted == m_last_highlighted) || !beginRepaint())
+        return;
+    m_last_text = footer_text;
+    m_last_highlighted = is_highlighted;
 
-    if (is_copy_mode_active || is_error_msg) {
-        attron(COLOR_PAIR(4));
-        attron(A_BOLD);
+    wattron(m_win, A_REVERSE);
+    mvwprintw(m_win, 0, 0, "%*s", m_w, "");
+
+    if (is_highlighted) {
+        wattron(m_win, COLOR_PAIR(4));
+        wattron(m_win, A_BOLD);
     }
 
     if ((int) footer_text.length() < m_w) {
-        mvprintw(m_y, (m_w - footer_text.length()) / 2, "%s", footer_text.c_str());
+        mvwprintw(m_win, 0, (m_w - footer_text.length()) / 2, "%s", footer_text.c_str());
     } else {
-        mvprintw(m_y, 1, "%s", truncate_string(footer_text, m_w - 2).c_str());
+        mvwprintw(m_win, 0, 1, "%s", truncate_string(footer_text, m_w - 2).c_str());
     }
 
-    if (is_copy_mode_active || is_error_msg) {
-        attroff(A_BOLD);
-        attroff(COLOR_PAIR(4));
+    if (is_highlighted) {
+        wattroff(m_win, A_BOLD);
+        wattroff(m_win, COLOR_PAIR(4));
     }
-    attroff(A_REVERSE);
+    wattroff(m_win, A_REVERSE);
+    endRepaint();
 }
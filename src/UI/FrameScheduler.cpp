@@ -0,0 +1,59 @@
+#include "UI/FrameScheduler.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+    constexpr const char* MAX_FPS_ENV_VAR = "STREAM_HOPPER_MAX_FPS";
+    constexpr const char* LOW_BANDWIDTH_ENV_VAR = "STREAM_HOPPER_LOW_BANDWIDTH";
+    constexpr int LOW_BANDWIDTH_MAX_FPS = 4;
+    constexpr int MIN_FPS = 1;
+    constexpr int MAX_FPS = 120;
+
+    bool is_remote_session() {
+        return getenv("SSH_CONNECTION") != nullptr || getenv("SSH_CLIENT") != nullptr || getenv("SSH_TTY") != nullptr;
+    }
+}
+
+RenderSettings RenderSettings::fromEnvironment() {
+    RenderSettings settings;
+
+    bool low_bandwidth = is_remote_session();
+    if (const char* value = getenv(LOW_BANDWIDTH_ENV_VAR)) {
+        low_bandwidth = std::strcmp(value, "0") != 0;
+    }
+    if (low_bandwidth) {
+        settings.max_fps = LOW_BANDWIDTH_MAX_FPS;
+        settings.animations_enabled = false;
+    }
+
+    if (const char* value = getenv(MAX_FPS_ENV_VAR)) {
+        int fps = std::atoi(value);
+        if (fps > 0) {
+            settings.max_fps = std::clamp(fps, MIN_FPS, MAX_FPS);
+        }
+    }
+    return settings;
+}
+
+FrameScheduler::FrameScheduler(int max_fps)
+    : m_min_interval(std::chrono::duration_cast<Clock::duration>(std::chrono::seconds(1)) /
+                     std::clamp(max_fps, MIN_FPS, MAX_FPS)) {}
+
+bool FrameScheduler::isFrameDue(Clock::time_point now) const {
+    return m_frame_pending && now - m_last_frame >= m_min_interval;
+}
+
+void FrameScheduler::frameRendered(Clock::time_point now) {
+    m_frame_pending = false;
+    m_last_frame = now;
+}
+
+int FrameScheduler::msUntilDue(Clock::time_point now) const {
+    auto wait = m_min_interval - (now - m_last_frame);
+    if (wait <= Clock::duration::zero())
+        return 0;
+    // Round up so the wakeup never lands just before the frame is allowed.
+    return static_cast<int>(std::chrono::ceil<std::chrono::milliseconds>(wait).count());
+}
@@ -16,6 +16,18 @@ namespace {
 }
 
 void HeaderBar::draw(double current_volume, HopperMode hopper_mode, AppMode app_mode, bool is_fetching) {
+    int volume = static_cast<int>(current_volume);
+    // While fetching, every frame advances the spinner.
+    bool spinning = is_fetching && m_animated;
+    bool unchanged = !spinning && is_fetching == m_last_fetching && volume == m_last_volume &&
+                     hopper_mode == m_last_hopper_mode && app_mode == m_last_app_mode;
+    if ((!m_dirty && unchanged) || !beginRepaint())
+        return;
+    m_last_volume = volume;
+    m_last_hopper_mode = hopper_mode;
+    m_last_app_mode = app_mode;
+    m_last_fetching = is_fetching;
+
     std::string mode_str;
     switch (hopper_mode) {
     case HopperMode::BALANCED:
@@ -31,16 +43,19 @@ void HeaderBar::draw(double current_volume, HopperMode hopper_mode, AppMode app_
 
     std::string play_mode_str = (app_mode == AppMode::RANDOM) ? "RANDOM" : "LIVE";
     if (is_fetching) {
-        spinner_idx = (spinner_idx + 1) % SPINNER_CHARS.size();
+        if (spinning) {
+            spinner_idx = (spinner_idx + 1) % SPINNER_CHARS.size();
+        }
         play_mode_str += " ";
         play_mode_str += SPINNER_CHARS[spinner_idx];
     }
 
     std::string full_header = " STREAM HOPPER  |  " + play_mode_str +
-                              "  |  " + mode_str + "  |  🔊 VOL: " + std::to_string((int) current_volume) + "% ";
+                              "  |  " + mode_str + "  |  🔊 VOL: " + std::to_string(volume) + "% ";
 
-    attron(A_REVERSE);
-    mvprintw(m_y, m_x, "%s", std::string(m_w, ' ').c_str());
-    mvprintw(m_y, m_x + 1, "%s", truncate_string(full_header, m_w - 2).c_str());
-    attroff(A_REVERSE);
+    wattron(m_win, A_REVERSE);
+    mvwprintw(m_win, 0, 0, "%s", std::string(m_w, ' ').c_str());
+    mvwprintw(m_win, 0, 1, "%s", truncate_string(full_header, m_w - 2).c_str());
+    wattroff(m_win, A_REVERSE);
+    endRepaint();
 }
@@ -2,44 +2,71 @@
 
 #include <ncurses.h>
 
-#include <iomanip>
-#include <sstream>
+#include <algorithm>
 
-#include "UI/StateSnapshot.h" // For StationDisplayData
+#include "UI/StateSnapshot.h" // For HistorySearchRow
 #include "UI/UIUtils.h"
 
-void HistoryPanel::draw(const StationDisplayData& /*station*/,
-                        const nlohmann::json& station_history,
-                        int scroll_offset,
-                        bool is_focused) {
+namespace {
+    constexpr int TIME_COLUMN_WIDTH = 9;
+    constexpr const char* COLUMN_SEPARATOR = "│ ";
+
+    // The time label padded to its column, followed by the separator.
+    std::string format_time_column(const HistoryTimeLabel& time_label) {
+        std::string column = time_label.data();
+        column.resize(std::max(column.size(), static_cast<size_t>(TIME_COLUMN_WIDTH)), ' ');
+        column += COLUMN_SEPARATOR;
+        return column;
+    }
+}
+
+void HistoryPanel::draw(const std::vector<HistoryDisplayRow>& rows, bool is_focused) {
     if (m_h <= 0)
         return;
-    draw_box(m_y, m_x, m_w, m_h, "📝 RECENT HISTORY", is_focused);
 
-    if (!station_history.empty()) {
-        int inner_w = m_w - 5;
-        int panel_height = m_h - 2;
+    int inner_w = m_w - 5;
+    int panel_height = m_h - 2;
+    // Columns left for the title once the time column and separator are printed.
+    int title_room = inner_w - TIME_COLUMN_WIDTH - static_cast<int>(display_width(COLUMN_SEPARATOR));
 
-        int display_count = 0;
-        auto start_it = station_history.rbegin();
-        if (scroll_offset < (int) station_history.size()) {
-            std::advance(start_it, scroll_offset);
+    std::vector<ListLine> lines;
+    for (const auto& row : rows) {
+        if ((int) lines.size() >= panel_height)
+            break;
+        std::string text = format_time_column(row.time_label);
+        if (title_room > 0) {
+            text += truncate_string(row.title, title_room);
+        } else {
+            text += row.title;
         }
+        lines.push_back({std::move(text), A_NORMAL});
+    }
+    present("📝 RECENT HISTORY", is_focused, 3, std::move(lines));
+}
 
-        for (auto it = start_it; it != station_history.rend() && display_count < panel_height; ++it, ++display_count) {
-            const auto& entry = *it;
-            if (entry.is_array() && entry.size() == 2) {
-                std::string full_ts = entry[0].get<std::string>();
-                std::string title_str = entry[1].get<std::string>();
-
-                std::string time_str = format_history_timestamp(full_ts);
+void HistoryPanel::drawSearch(const std::string& query, const std::vector<HistorySearchRow>& rows, int selected) {
+    if (m_h <= 0)
+        return;
 
-                std::stringstream line_ss;
-                line_ss << std::setw(9) << std::left << time_str << "│ " << title_str;
+    int inner_w = m_w - 5;
+    int panel_height = m_h - 2;
+    int text_room = inner_w - TIME_COLUMN_WIDTH - static_cast<int>(display_width(COLUMN_SEPARATOR));
 
-                mvwprintw(stdscr, m_y + 1 + display_count, m_x + 3, "%s",
-                          truncate_string(line_ss.str(), inner_w).c_str());
+    std::vector<ListLine> lines;
+    if (panel_height > 0 && text_room > 0) {
+        if (rows.empty()) {
+            const char* hint = query.empty() ? "Type words from a song title" : "No matching songs";
+            lines.push_back({truncate_string(hint, inner_w), A_DIM});
+        } else {
+            int first = selected >= panel_height ? selected - panel_height + 1 : 0;
+            for (int i = 0; i < panel_height && first + i < (int) rows.size(); ++i) {
+                const auto& row = rows[first + i];
+                std::string text = truncate_string(row.title + "  @ " + row.station_name, text_room);
+                text.append(text_room - std::min<size_t>(display_width(text), text_room), ' '); // Full-width highlight
+                lines.push_back({format_time_column(row.time_label) + text,
+                                 first + i == selected ? A_REVERSE : A_NORMAL});
             }
         }
     }
+    present("🔍 SONGS: " + query + "_", true, 3, std::move(lines));
 }
@@ -0,0 +1,20 @@
+#include "UI/ListPanel.h"
+
+#include "UI/UIUtils.h"
+
+void ListPanel::present(const std::string& title, bool is_focused, int text_x, std::vector<ListLine> lines) {
+    if (!m_dirty && title == m_last_title && is_focused == m_last_focused && lines == m_last_lines)
+        return;
+    if (!beginRepaint())
+        return;
+    draw_box(m_win, title, is_focused);
+    for (size_t i = 0; i < lines.size(); ++i) {
+        wattron(m_win, lines[i].attrs);
+        mvwprintw(m_win, 1 + static_cast<int>(i), text_x, "%s", lines[i].text.c_str());
+        wattroff(m_win, lines[i].attrs);
+    }
+    endRepaint();
+    m_last_title = title;
+    m_last_focused = is_focused;
+    m_last_lines = std::move(lines);
+}
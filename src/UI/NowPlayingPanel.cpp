@@ -15,12 +15,28 @@ namespace {
 }
 
 void NowPlayingPanel::draw(const StateSnapshot& snapshot) {
-    if (snapshot.stations.empty())
+    const StationDisplayData* active_station = snapshot.activeStation();
+    if (!active_station)
         return;
-    const auto& station = snapshot.stations[snapshot.active_station_idx];
+    const auto& station = *active_station;
+
+    // A URL cycle animates its spinner, so it repaints every frame.
+    bool spinning = station.cycling_state == CyclingState::CYCLING && m_animated;
+    bool unchanged = station == m_last_station && !spinning &&
+                     snapshot.is_auto_hop_mode_active == m_last_auto_hop &&
+                     snapshot.auto_hop_remaining_seconds == m_last_auto_hop_remaining &&
+                     snapshot.auto_hop_total_duration == m_last_auto_hop_total &&
+                     snapshot.is_volume_offset_mode_active == m_last_volume_offset_mode;
+    if ((!m_dirty && unchanged) || !beginRepaint())
+        return;
+    m_last_station = station;
+    m_last_auto_hop = snapshot.is_auto_hop_mode_active;
+    m_last_auto_hop_remaining = snapshot.auto_hop_remaining_seconds;
+    m_last_auto_hop_total = snapshot.auto_hop_total_duration;
+    m_last_volume_offset_mode = snapshot.is_volume_offset_mode_active;
 
     std::string box_title = snapshot.is_auto_hop_mode_active ? "🤖 AUTO-HOP MODE" : "▶️  NOW PLAYING";
-    draw_box(m_y, m_x, m_w, m_h, box_title, false);
+    draw_box(m_win, box_title, false);
 
     int inner_w = m_w - 4;
 
@@ -36,9 +52,9 @@ void NowPlayingPanel::draw(const StateSnapshot& snapshot) {
         title_to_show = station.current_title;
     }
 
-    attron(A_BOLD);
-    mvwprintw(stdscr, m_y + 2, m_x + 3, "%s", truncate_string(title_to_show, inner_w - 2).c_str());
-    attroff(A_BOLD);
+    wattron(m_win, A_BOLD);
+    mvwprintw(m_win, 2, 3, "%s", truncate_string(title_to_show, inner_w - 2).c_str());
+    wattroff(m_win, A_BOLD);
 
     int bitrate = station.is_initialized ? station.bitrate : 0;
     std::string bitrate_str;
@@ -48,7 +64,11 @@ void NowPlayingPanel::draw(const StateSnapshot& snapshot) {
 
     if (station.cycling_state == CyclingState::IDLE) {
         size_t max_name_width = inner_w - bitrate_str.length() - 2;
-        mvwprintw(stdscr, m_y + 3, m_x + 3, "%s", truncate_string(station.name, max_name_width).c_str());
+        std::string name_line = station.name;
+        if (station.reconnect_failures > 0) {
+            name_line += " (dropped " + std::to_string(station.reconnect_failures) + "x)";
+        }
+        mvwprintw(m_win, 3, 3, "%s", truncate_string(name_line, max_name_width).c_str());
     } else {
         drawCycleStatus(station, inner_w);
     }
@@ -62,9 +82,9 @@ void NowPlayingPanel::draw(const StateSnapshot& snapshot) {
         else
             color_pair_num = 7;
 
-        attron(COLOR_PAIR(color_pair_num));
-        mvwprintw(stdscr, m_y + 2, m_x + m_w - bitrate_str.length() - 3, "%s", bitrate_str.c_str());
-        attroff(COLOR_PAIR(color_pair_num));
+        wattron(m_win, COLOR_PAIR(color_pair_num));
+        mvwprintw(m_win, 2, m_w - bitrate_str.length() - 3, "%s", bitrate_str.c_str());
+        wattroff(m_win, COLOR_PAIR(color_pair_num));
     }
 
     if (snapshot.is_auto_hop_mode_active) {
@@ -74,6 +94,7 @@ void NowPlayingPanel::draw(const StateSnapshot& snapshot) {
     } else {
         drawNormalView(station, inner_w);
     }
+    endRepaint();
 }
 
 void NowPlayingPanel::drawVolumeOffsetBar(const StationDisplayData& station, int inner_w) {
@@ -81,40 +102,42 @@ void NowPlayingPanel::drawVolumeOffsetBar(const StationDisplayData& station, int
     if (bar_width <= 0)
         return;
 
-    mvwprintw(stdscr, m_y + 1, m_x + 3, "🎚️ NORM [");
-    int bar_start_x = m_x + 12;
+    mvwprintw(m_win, 1, 3, "🎚️ NORM [");
+    int bar_start_x = 12;
 
     int center_point = bar_width / 2;
     double offset = station.volume_offset;
     // Use the public constant for the range calculation
     int fill_width = static_cast<int>((offset / VolumeNormalizer::MAX_OFFSET) * center_point);
 
-    attron(COLOR_PAIR(9)); // Yellow
+    wattron(m_win, COLOR_PAIR(9)); // Yellow
     for (int i = 0; i < bar_width; ++i) {
         if (fill_width > 0 && i >= center_point && i < center_point + fill_width) {
-            mvwaddch(stdscr, m_y + 1, bar_start_x + i, ACS_BLOCK);
+            mvwaddch(m_win, 1, bar_start_x + i, ACS_BLOCK);
         } else if (fill_width < 0 && i < center_point && i >= center_point + fill_width) {
-            mvwaddch(stdscr, m_y + 1, bar_start_x + i, ACS_BLOCK);
+            mvwaddch(m_win, 1, bar_start_x + i, ACS_BLOCK);
         } else if (i == center_point) {
-            mvwaddch(stdscr, m_y + 1, bar_start_x + i, ACS_VLINE);
+            mvwaddch(m_win, 1, bar_start_x + i, ACS_VLINE);
         } else {
-            mvwaddch(stdscr, m_y + 1, bar_start_x + i, ACS_CKBOARD);
+            mvwaddch(m_win, 1, bar_start_x + i, ACS_CKBOARD);
         }
     }
-    attroff(COLOR_PAIR(9));
+    wattroff(m_win, COLOR_PAIR(9));
 
-    mvwprintw(stdscr, m_y + 1, bar_start_x + bar_width, "]");
+    mvwprintw(m_win, 1, bar_start_x + bar_width, "]");
 
     std::stringstream ss;
     ss << std::fixed << std::showpos << std::setprecision(1) << offset;
-    mvwprintw(stdscr, m_y + 1, bar_start_x + bar_width + 2, "%s", ss.str().c_str());
+    mvwprintw(m_win, 1, bar_start_x + bar_width + 2, "%s", ss.str().c_str());
 }
 
 void NowPlayingPanel::drawCycleStatus(const StationDisplayData& station, int inner_w) {
     std::string status_text;
     switch (station.cycling_state) {
     case CyclingState::CYCLING: {
-        spinner_idx = (spinner_idx + 1) % SPINNER_CHARS.size();
+        if (m_animated) {
+            spinner_idx = (spinner_idx + 1) % SPINNER_CHARS.size();
+        }
         char spinner = SPINNER_CHARS[spinner_idx];
         std::stringstream ss;
         std::string pending_str = (station.pending_bitrate > 0) ? std::to_string(station.pending_bitrate) + "k" : "...";
@@ -132,7 +155,7 @@ void NowPlayingPanel::drawCycleStatus(const StationDisplayData& station, int inn
         status_text = station.name;
         break;
     }
-    mvwprintw(stdscr, m_y + 3, m_x + 3, "%s", truncate_string(status_text, inner_w).c_str());
+    mvwprintw(m_win, 3, 3, "%s", truncate_string(status_text, inner_w).c_str());
 }
 
 void NowPlayingPanel::drawAutoHopView(int inner_w, int remaining_seconds, int total_duration) {
@@ -143,16 +166,16 @@ void NowPlayingPanel::drawAutoHopView(int inner_w, int remaining_seconds, int to
             elapsed_percent = static_cast<double>(total_duration - remaining_seconds) / total_duration;
         }
         int filled_width = static_cast<int>(elapsed_percent * bar_width);
-        mvwprintw(stdscr, m_y + m_h - 2, m_x + 2, "[");
-        attron(COLOR_PAIR(2));
+        mvwprintw(m_win, m_h - 2, 2, "[");
+        wattron(m_win, COLOR_PAIR(2));
         for (int i = 0; i < filled_width; ++i)
-            mvwaddch(stdscr, m_y + m_h - 2, m_x + 3 + i, ACS_BLOCK);
-        attroff(COLOR_PAIR(2));
+            mvwaddch(m_win, m_h - 2, 3 + i, ACS_BLOCK);
+        wattroff(m_win, COLOR_PAIR(2));
         for (int i = filled_width; i < bar_width; ++i)
-            mvwaddch(stdscr, m_y + m_h - 2, m_x + 3 + i, '.');
-        mvwprintw(stdscr, m_y + m_h - 2, m_x + 3 + bar_width, "]");
+            mvwaddch(m_win, m_h - 2, 3 + i, '.');
+        mvwprintw(m_win, m_h - 2, 3 + bar_width, "]");
         std::string time_text = "Next in " + std::to_string(remaining_seconds) + "s";
-        mvwprintw(stdscr, m_y + 1, m_x + m_w - time_text.length() - 2, "%s", time_text.c_str());
+        mvwprintw(m_win, 1, m_w - time_text.length() - 2, "%s", time_text.c_str());
     }
 }
 
@@ -162,14 +185,14 @@ void NowPlayingPanel::drawNormalView(const StationDisplayData& station, int inne
         bool is_muted = !station.is_initialized || station.playback_state == PlaybackState::Muted;
         double vol_percent = (is_muted ? 0.0 : station.current_volume) / 100.0;
         int filled_width = static_cast<int>(vol_percent * bar_width);
-        mvwprintw(stdscr, m_y + 1, m_x + 3, "🔊 [");
-        attron(COLOR_PAIR(2));
+        mvwprintw(m_win, 1, 3, "🔊 [");
+        wattron(m_win, COLOR_PAIR(2));
         for (int i = 0; i < filled_width; ++i)
-            mvwaddch(stdscr, m_y + 1, m_x + 6 + i, ACS_BLOCK);
-        attroff(COLOR_PAIR(2));
+            mvwaddch(m_win, 1, 6 + i, ACS_BLOCK);
+        wattroff(m_win, COLOR_PAIR(2));
         for (int i = filled_width; i < bar_width; ++i)
-            mvwaddch(stdscr, m_y + 1, m_x + 6 + i, ACS_CKBOARD);
-        mvwprintw(stdscr, m_y + 1, m_x + 6 + bar_width, "]");
-        mvwprintw(stdscr, m_y + 1, m_x + 8 + bar_width, "%.0f%%", is_muted ? 0.0 : station.current_volume);
+            mvwaddch(m_win, 1, 6 + i, ACS_CKBOARD);
+        mvwprintw(m_win, 1, 6 + bar_width, "]");
+        mvwprintw(m_win, 1, 8 + bar_width, "%.0f%%", is_muted ? 0.0 : station.current_volume);
     }
 }
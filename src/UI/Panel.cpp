@@ -1,2 +1,47 @@
 #include "UI/Panel.h"
-// No implementation needed here for now
+
+#include "Core/Metrics.h"
+
+Panel::~Panel() {
+    if (m_win) {
+        delwin(m_win);
+    }
+}
+
+void Panel::setDimensions(int y, int x, int w, int h) {
+    if (m_win && y == m_y && x == m_x && w == m_w && h == m_h) {
+        return;
+    }
+    m_y = y;
+    m_x = x;
+    m_w = w;
+    m_h = h;
+    if (m_win) {
+        delwin(m_win);
+        m_win = nullptr;
+    }
+    if (w > 0 && h > 0) {
+        m_win = newwin(h, w, y, x);
+    }
+    m_dirty = true;
+}
+
+void Panel::blank() {
+    if (m_win) {
+        werase(m_win);
+        wnoutrefresh(m_win);
+    }
+    m_dirty = true;
+}
+
+bool Panel::beginRepaint() {
+    if (!m_win) {
+        return false;
+    }
+    werase(m_win);
+    m_dirty = false;
+    Metrics::increment("ui.panel_repaints");
+    return true;
+}
+
+void Panel::endRepaint() { wnoutrefresh(m_win); }
@@ -2,6 +2,8 @@
 
 #include <ncurses.h>
 
+#include <algorithm>
+
 #include "RadioStream.h"      // For PlaybackState
 #include "UI/StateSnapshot.h" // For StationDisplayData
 #include "UI/UIUtils.h"
@@ -10,7 +12,16 @@ StationsPanel::StationsPanel() : m_station_scroll_offset(0) {}
 
 std::string StationsPanel::getStationStatusString(const StationDisplayData& station) const {
     if (!station.is_initialized) {
-        return "   ";
+        return station.is_unreachable ? "💀 " : "   ";
+    }
+    switch (station.reconnect_state) {
+    case ReconnectState::WAITING:
+    case ReconnectState::CONNECTING:
+        return "🔄 ";
+    case ReconnectState::PARKED:
+        return "💤 ";
+    default:
+        break;
     }
     if (station.is_buffering) {
         return "🤔 ";
@@ -31,31 +42,28 @@ std::string StationsPanel::getStationStatusString(const StationDisplayData& stat
     return "   ";
 }
 
-void StationsPanel::drawStationLine(int y, const StationDisplayData& station, bool is_selected, int inner_w) {
-    if (is_selected) {
-        attron(A_REVERSE);
-    } else if (!station.is_initialized) {
-        attron(A_DIM);
-    }
-
+StationsPanel::ListLine
+StationsPanel::formatStationLine(const StationDisplayData& station, bool is_selected, int inner_w) const {
     std::string status_icon = getStationStatusString(station);
     std::string fav_icon = station.is_favorite ? "⭐ " : "  ";
-    std::string line = status_icon + fav_icon + station.name;
-
-    mvwprintw(stdscr, y, m_x + 2, "%-*s", inner_w + 1, truncate_string(line, inner_w).c_str());
-
+    ListLine line{truncate_string(status_icon + fav_icon + station.name, inner_w), A_NORMAL};
     if (is_selected) {
-        attroff(A_REVERSE);
+        line.attrs = A_REVERSE;
+        line.text.resize(std::max(line.text.size(), static_cast<size_t>(inner_w + 1)), ' '); // Full-width highlight
     } else if (!station.is_initialized) {
-        attroff(A_DIM);
+        line.attrs = A_DIM;
     }
+    return line;
 }
 
-void StationsPanel::draw(const std::vector<StationDisplayData>& stations, int active_station_idx, bool is_focused) {
-    draw_box(m_y, m_x, m_w, m_h, "STATIONS", is_focused);
+void StationsPanel::draw(const std::vector<StationDisplayData>& stations,
+                         int window_start,
+                         int total_station_count,
+                         int active_station_idx,
+                         bool is_focused) {
     int inner_w = m_w - 4;
 
-    int visible_items = m_h > 2 ? m_h - 2 : 0;
+    int visible_items = getVisibleRows();
     if (active_station_idx < m_station_scroll_offset) {
         m_station_scroll_offset = active_station_idx;
     }
@@ -63,12 +71,40 @@ void StationsPanel::draw(const std::vector<StationDisplayData>& stations, int ac
         m_station_scroll_offset = active_station_idx - visible_items + 1;
     }
 
+    std::vector<ListLine> lines;
     for (int i = 0; i < visible_items; ++i) {
         int station_idx = m_station_scroll_offset + i;
-        if (station_idx >= (int) stations.size())
+        if (station_idx >= total_station_count)
             break;
+        int window_idx = station_idx - window_start;
+        if (window_idx < 0 || window_idx >= (int) stations.size()) {
+            lines.push_back({"", A_NORMAL}); // Outside the snapshot window; only happens for a frame after a resize
+            continue;
+        }
 
         bool is_selected = (station_idx == active_station_idx);
-        drawStationLine(m_y + 1 + i, stations[station_idx], is_selected, inner_w);
+        lines.push_back(formatStationLine(stations[window_idx], is_selected, inner_w));
+    }
+    present("STATIONS", is_focused, 2, std::move(lines));
+}
+
+void StationsPanel::drawSearch(const std::string& query, const std::vector<StationSearchRow>& results, int selected) {
+    int inner_w = m_w - 4;
+    int visible_items = getVisibleRows();
+
+    std::vector<ListLine> lines;
+    if (results.empty()) {
+        const char* hint = query.empty() ? "Type a station name or tag" : "No matching stations";
+        if (visible_items > 0) {
+            lines.push_back({truncate_string(hint, inner_w), A_DIM});
+        }
+    } else {
+        // Keep the selection on screen; results are few, so a simple page offset is enough.
+        int first = selected >= visible_items ? selected - visible_items + 1 : 0;
+        for (int i = 0; i < visible_items && first + i < (int) results.size(); ++i) {
+            int result_idx = first + i;
+            lines.push_back(formatStationLine(results[result_idx].station, result_idx == selected, inner_w));
+        }
     }
+    present("🔍 FIND: " + query + "_", true, 2, std::move(lines));
 }
@@ -4,77 +4,67 @@
 
 #include <algorithm> // For std::search
 #include <cctype>    // For std::toupper
-#include <chrono>
-#include <ctime>
-#include <iomanip>
-#include <sstream>
+#include <cwchar>    // For mbrtowc, wcwidth
 
-std::string truncate_string(const std::string& str, size_t width) {
-    if (width > 3 && str.length() > width) {
-        return str.substr(0, width - 3) + "...";
+namespace {
+    // Decodes the character at `pos`; returns its byte length and sets its column width.
+    size_t next_char(std::string_view str, size_t pos, size_t& columns) {
+        std::mbstate_t state{};
+        wchar_t wc = 0;
+        size_t length = std::mbrtowc(&wc, str.data() + pos, str.size() - pos, &state);
+        if (length == static_cast<size_t>(-1) || length == static_cast<size_t>(-2) || length == 0) {
+            columns = 1; // Invalid or truncated sequence: step over one byte
+            return 1;
+        }
+        int width = wcwidth(wc);
+        columns = width < 0 ? 0 : static_cast<size_t>(width);
+        return length;
     }
-    return str;
 }
 
-std::string format_history_timestamp(const std::string& ts_str) {
-    std::tm tm = {};
-    std::stringstream ss(ts_str);
-    ss >> std::get_time(&tm, "%Y-%m-%d %H:%M:%S");
-    if (ss.fail()) {
-        return ts_str.substr(0, 5);
+size_t display_width(std::string_view str) {
+    size_t total = 0;
+    for (size_t pos = 0, columns = 0; pos < str.size(); total += columns) {
+        pos += next_char(str, pos, columns);
     }
+    return total;
+}
 
-    auto entry_time = std::chrono::system_clock::from_time_t(std::mktime(&tm));
-    auto now = std::chrono::system_clock::now();
-
-    time_t t_now = std::chrono::system_clock::to_time_t(now);
-    std::tm tm_now = *std::localtime(&t_now);
-    tm_now.tm_hour = 0;
-    tm_now.tm_min = 0;
-    tm_now.tm_sec = 0;
-    auto today_start = std::chrono::system_clock::from_time_t(std::mktime(&tm_now));
-
-    std::stringstream time_ss;
-    if (entry_time >= today_start) {
-        time_ss << std::put_time(&tm, "%H:%M");
-        return time_ss.str();
+std::string truncate_string(std::string_view str, size_t width) {
+    if (width <= 3 || display_width(str) <= width) {
+        return std::string(str);
     }
-
-    auto yesterday_start = today_start - std::chrono::hours(24);
-    if (entry_time >= yesterday_start) {
-        return "Yesterday";
+    size_t pos = 0, used = 0;
+    while (pos < str.size()) {
+        size_t columns = 0;
+        size_t length = next_char(str, pos, columns);
+        if (used + columns > width - 3)
+            break;
+        pos += length;
+        used += columns;
     }
-
-    time_ss << std::put_time(&tm, "%b %d");
-    return time_ss.str();
+    return std::string(str.substr(0, pos)) + "...";
 }
 
-void draw_box(int y, int x, int w, int h, const std::string& title, bool is_focused) {
+void draw_box(WINDOW* win, const std::string& title, bool is_focused) {
     if (is_focused) {
-        attron(COLOR_PAIR(3));
+        wattron(win, COLOR_PAIR(3));
     }
 
-    mvwhline(stdscr, y, x + 1, ACS_HLINE, w - 2);
-    mvwhline(stdscr, y + h - 1, x + 1, ACS_HLINE, w - 2);
-    mvwvline(stdscr, y + 1, x, ACS_VLINE, h - 2);
-    mvwvline(stdscr, y + 1, x + w - 1, ACS_VLINE, h - 2);
-    mvwaddch(stdscr, y, x, ACS_ULCORNER);
-    mvwaddch(stdscr, y, x + w - 1, ACS_URCORNER);
-    mvwaddch(stdscr, y + h - 1, x, ACS_LLCORNER);
-    mvwaddch(stdscr, y + h - 1, x + w - 1, ACS_LRCORNER);
+    box(win, 0, 0);
 
     if (!title.empty()) {
         if (is_focused) {
-            attron(A_BOLD);
+            wattron(win, A_BOLD);
         }
-        mvwprintw(stdscr, y, x + 3, " %s ", title.c_str());
+        mvwprintw(win, 0, 3, " %s ", title.c_str());
         if (is_focused) {
-            attroff(A_BOLD);
+            wattroff(win, A_BOLD);
         }
     }
 
     if (is_focused) {
-        attroff(COLOR_PAIR(3));
+        wattroff(win, COLOR_PAIR(3));
     }
 }
 
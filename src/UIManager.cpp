@@ -1,13 +1,22 @@
 #include "UIManager.h"
 
+#include <fcntl.h>
 #include <locale.h>
 #include <ncurses.h>
+#include <poll.h>
+#include <unistd.h>
 
 #include <algorithm>
+#include <chrono>
 #include <csignal>
+#include <cstdlib>
+#include <cstring>
 #include <string>
 #include <vector>
 
+#include "Core/Metrics.h"
+#include "Core/WakeupSignal.h"
+
 #include "UI/FooterBar.h"
 #include "UI/HeaderBar.h"
 #include "UI/HistoryPanel.h"
@@ -19,20 +28,59 @@
 
 namespace {
     constexpr int COMPACT_MODE_WIDTH = 80;
-    constexpr int DEFAULT_INPUT_TIMEOUT = 100;
+    constexpr int ESCAPE_DELAY_MS = 25;
+    constexpr const char* THREAD_IO_STATS = "/proc/thread-self/io";
+
+    // Bytes written by the calling thread so far, or -1 if the kernel doesn't say.
+    // ncurses writes straight to the terminal's file descriptor, so the UI
+    // thread's write counter around doupdate() is exactly the frame's output.
+    long thread_bytes_written(int stats_fd) {
+        if (stats_fd < 0)
+            return -1;
+        char buffer[512];
+        ssize_t n = pread(stats_fd, buffer, sizeof(buffer) - 1, 0);
+        if (n <= 0)
+            return -1;
+        buffer[n] = '\0';
+        const char* field = std::strstr(buffer, "wchar:");
+        return field ? std::strtol(field + 6, nullptr, 10) : -1;
+    }
 }
 
+std::atomic<WakeupSignal*> UIManager::s_signal_wakeup = nullptr;
+void UIManager::notify_signal_wakeup() {
+    if (WakeupSignal* wakeup = s_signal_wakeup.load()) {
+        wakeup->notify();
+    }
+}
 std::atomic<bool> UIManager::s_resize_pending = false;
-void UIManager::resize_handler_trampoline(int) { s_resize_pending = true; }
+void UIManager::resize_handler_trampoline(int) {
+    s_resize_pending = true;
+    notify_signal_wakeup();
+}
+std::atomic<bool> UIManager::s_suspend_pending = false;
+void UIManager::suspend_handler_trampoline(int) {
+    s_suspend_pending = true;
+    notify_signal_wakeup();
+}
 UIManager::UIManager() : m_is_compact_mode(false) {
+    // Whichever thread a signal lands on, the handler wakes the UI out of poll().
+    m_signal_wakeup = std::make_unique<WakeupSignal>();
+    s_signal_wakeup = m_signal_wakeup.get();
     setlocale(LC_ALL, "");
     setlocale(LC_NUMERIC, "C");
+    // Installed before initscr() so ncurses leaves Ctrl-Z to us.
+    struct sigaction suspend_action{};
+    suspend_action.sa_handler = UIManager::suspend_handler_trampoline;
+    sigemptyset(&suspend_action.sa_mask);
+    sigaction(SIGTSTP, &suspend_action, nullptr);
     initscr();
     cbreak();
     noecho();
     curs_set(0);
     keypad(stdscr, TRUE);
-    timeout(DEFAULT_INPUT_TIMEOUT);
+    set_escdelay(ESCAPE_DELAY_MS); // Esc closes the finder; don't wait a full second for it
+    nodelay(stdscr, TRUE); // Keys are only read once waitForEvents() says they have arrived
     start_color();
     use_default_colors();
     init_pair(1, COLOR_YELLOW, -1);
@@ -50,20 +98,70 @@ UIManager::UIManager() : m_is_compact_mode(false) {
     m_stations_panel = std::make_unique<StationsPanel>();
     m_now_playing_panel = std::make_unique<NowPlayingPanel>();
     m_history_panel = std::make_unique<HistoryPanel>();
-    int width, height;
-    getmaxyx(stdscr, width, height);
-    (void) height;
-    updateLayoutStrategy(width);
+    // Panels draw into their own windows; stdscr only needs to be flushed once so
+    // getch() never finds it pending and paints it over them.
+    refresh();
+    // Opened here so it refers to the UI thread, which is the one that draws.
+    m_io_stats_fd = open(THREAD_IO_STATS, O_RDONLY | O_CLOEXEC);
 }
 UIManager::~UIManager() {
+    // Panel windows belong to the screen, so they go first.
+    m_header_bar.reset();
+    m_footer_bar.reset();
+    m_stations_panel.reset();
+    m_now_playing_panel.reset();
+    m_history_panel.reset();
     if (stdscr != NULL && !isendwin()) {
         endwin();
     }
+    if (m_io_stats_fd >= 0) {
+        close(m_io_stats_fd);
+    }
+    s_signal_wakeup = nullptr;
+}
+void UIManager::waitForEvents(int wakeup_fd, int timeout_ms) {
+    // A negative fd is skipped by poll(), so callers can leave out their own.
+    struct pollfd fds[] = {
+        {STDIN_FILENO, POLLIN, 0},
+        {m_signal_wakeup->fd(), POLLIN, 0},
+        {wakeup_fd, POLLIN, 0},
+    };
+    poll(fds, 3, timeout_ms); // EINTR is fine: the handler has already recorded the signal
+    m_signal_wakeup->drain();
+    Metrics::increment("ui.wakeups");
 }
-void UIManager::setInputTimeout(int milliseconds) { timeout(milliseconds); }
 void UIManager::handleResize() {
     endwin();
     refresh();
+    m_layout_valid = false;
+}
+
+bool UIManager::takeSuspendRequest() { return s_suspend_pending.exchange(false); }
+
+void UIManager::suspend() {
+    endwin();
+    signal(SIGTSTP, SIG_DFL);
+    raise(SIGTSTP); // Every thread stops here until SIGCONT
+    struct sigaction suspend_action{};
+    suspend_action.sa_handler = UIManager::suspend_handler_trampoline;
+    sigemptyset(&suspend_action.sa_mask);
+    sigaction(SIGTSTP, &suspend_action, nullptr);
+    Metrics::increment("ui.suspends");
+}
+
+bool UIManager::isForeground() const {
+    pid_t foreground_group = tcgetpgrp(STDIN_FILENO);
+    return foreground_group < 0 || foreground_group == getpgrp(); // Not a terminal: nothing to yield to
+}
+
+void UIManager::invalidateScreen() {
+    clearok(curscr, TRUE); // The shell drew over us; don't trust what ncurses thinks is on screen
+    m_layout_valid = false;
+}
+
+void UIManager::setAnimationsEnabled(bool enabled) {
+    m_header_bar->setAnimated(enabled);
+    m_now_playing_panel->setAnimated(enabled);
 }
 void UIManager::updateLayoutStrategy(int width) {
     bool should_be_compact = (width < COMPACT_MODE_WIDTH);
@@ -76,39 +174,84 @@ void UIManager::updateLayoutStrategy(int width) {
     }
 }
 
-void UIManager::draw(const StateSnapshot& snapshot) {
-    clear();
+void UIManager::updateLayout(const StateSnapshot& snapshot) {
     int height, width;
     getmaxyx(stdscr, height, width);
+    // Only the terminal size and the auto-hop panel height affect the layout.
+    if (m_layout_valid && width == m_layout_width && height == m_layout_height &&
+        snapshot.is_auto_hop_mode_active == m_layout_auto_hop) {
+        return;
+    }
     updateLayoutStrategy(width);
     m_layout_strategy->calculateDimensions(width, height, *m_header_bar, *m_footer_bar, *m_stations_panel,
                                            *m_now_playing_panel, *m_history_panel, snapshot);
+    m_layout_valid = true;
+    m_layout_width = width;
+    m_layout_height = height;
+    m_layout_auto_hop = snapshot.is_auto_hop_mode_active;
+
+    // Wipe whatever the old layout left behind; every panel repaints over it.
+    werase(stdscr);
+    wnoutrefresh(stdscr);
+    m_header_bar->invalidate();
+    m_footer_bar->invalidate();
+    m_stations_panel->invalidate();
+    m_now_playing_panel->invalidate();
+    m_history_panel->invalidate();
+}
+
+void UIManager::draw(const StateSnapshot& snapshot) {
+    auto start = std::chrono::steady_clock::now();
+    updateLayout(snapshot);
     m_header_bar->draw(snapshot.current_volume_for_header, snapshot.hopper_mode, snapshot.app_mode,
                        snapshot.is_fetching_stations);
 
     bool can_cycle_url = false;
-    if (!snapshot.stations.empty() && snapshot.active_station_idx >= 0) {
-        can_cycle_url = snapshot.stations[snapshot.active_station_idx].url_count > 1;
+    if (const StationDisplayData* active_station = snapshot.activeStation()) {
+        can_cycle_url = active_station->url_count > 1;
     }
 
     m_footer_bar->draw(snapshot.app_mode, m_is_compact_mode, snapshot.is_copy_mode_active,
-                       snapshot.is_auto_hop_mode_active, can_cycle_url, snapshot.temporary_status_message);
+                       snapshot.is_auto_hop_mode_active, can_cycle_url, snapshot.is_search_active,
+                       snapshot.temporary_status_message);
 
     if (snapshot.stations.empty()) {
-        refresh();
-        return;
-    }
-    const StationDisplayData& current_station = snapshot.stations[snapshot.active_station_idx];
-    m_stations_panel->draw(snapshot.stations, snapshot.active_station_idx,
-                           snapshot.active_panel == ActivePanel::STATIONS && !snapshot.is_copy_mode_active);
+        m_stations_panel->blank();
+        m_now_playing_panel->blank();
+        m_history_panel->blank();
+    } else {
+        if (snapshot.is_search_active && snapshot.search_scope == SearchScope::STATIONS) {
+            m_stations_panel->drawSearch(snapshot.search_query, snapshot.station_search_results,
+                                         snapshot.search_selected);
+        } else {
+            m_stations_panel->draw(snapshot.stations, snapshot.station_window_start, snapshot.total_station_count,
+                                   snapshot.active_station_idx,
+                                   snapshot.active_panel == ActivePanel::STATIONS && !snapshot.is_copy_mode_active);
+        }
 
-    m_now_playing_panel->draw(snapshot);
+        m_now_playing_panel->draw(snapshot);
 
-    m_history_panel->draw(current_station, snapshot.active_station_history, snapshot.history_scroll_offset,
-                          snapshot.active_panel == ActivePanel::HISTORY && !snapshot.is_copy_mode_active);
-    refresh();
+        if (snapshot.is_search_active && snapshot.search_scope == SearchScope::HISTORY) {
+            m_history_panel->drawSearch(snapshot.search_query, snapshot.history_search_results,
+                                        snapshot.search_selected);
+        } else {
+            m_history_panel->draw(snapshot.active_station_history,
+                                  snapshot.active_panel == ActivePanel::HISTORY && !snapshot.is_copy_mode_active);
+        }
+    }
+    // Everything repainted above was queued with wnoutrefresh(); send it in one go.
+    long bytes_before = thread_bytes_written(m_io_stats_fd);
+    doupdate();
+    long bytes_after = thread_bytes_written(m_io_stats_fd);
+    if (bytes_before >= 0 && bytes_after >= bytes_before) {
+        Metrics::increment("ui.terminal_bytes", bytes_after - bytes_before);
+    }
+    Metrics::increment("ui.frames");
+    Metrics::recordDuration("ui.draw", std::chrono::steady_clock::now() - start);
 }
 
+int UIManager::getStationViewportRows() const { return m_stations_panel->getVisibleRows(); }
+
 int UIManager::getInput() {
     if (s_resize_pending.exchange(false)) {
         handleResize();
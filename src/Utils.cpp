@@ -1,11 +1,9 @@
 #include "Utils.h"
 
-#include <array>
 #include <cstdio>
 #include <cstdlib>
 #include <iomanip>
 #include <iostream>
-#include <memory>
 #include <sstream>
 #include <stdexcept> // Required for std::runtime_error
 
@@ -81,29 +79,3 @@ bool execute_open_command(const std::string& url, std::string& error_message) {
     system(full_cmd.c_str());
     return true;
 }
-
-// Custom deleter for FILE* from popen.
-struct PcloseDeleter {
-    void operator()(FILE* fp) const {
-        if (fp) {
-            pclose(fp);
-        }
-    }
-};
-
-// Executes a shell command and captures its stdout.
-// Throws a runtime_error on failure.
-std::string exec_process(const char* cmd) {
-    std::array<char, 128> buffer;
-    std::string result;
-    // Redirect stderr to stdout to capture all output.
-    std::string command_with_redirect = std::string(cmd) + " 2>&1";
-    std::unique_ptr<FILE, PcloseDeleter> pipe(popen(command_with_redirect.c_str(), "r"));
-    if (!pipe) {
-        throw std::runtime_error("popen() failed!");
-    }
-    while (fgets(buffer.data(), buffer.size(), pipe.get()) != nullptr) {
-        result += buffer.data();
-    }
-    return result;
-}
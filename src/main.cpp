@@ -34,8 +34,18 @@ void print_help() {
     std::cout << "  (no command)         Launches the interactive radio player." << std::endl;
     std::cout << "                       If 'stations.jsonc' is not found, a setup wizard will run." << std::endl;
     std::cout << "  --from <file>        Launches the player with a specific station file." << std::endl;
-    std::cout << "  --curate <genre>     Starts an interactive session to curate stations for a genre." << std::endl;
+    std::cout << "  --curate <genre> [--limit <n>]" << std::endl;
+    std::cout << "                       Starts an interactive session to curate up to n stations (default "
+              << CliHandler::DEFAULT_CURATION_LIMIT << ") for a genre." << std::endl;
     std::cout << "  --list-tags          Lists popular, available genres from the Radio Browser API." << std::endl;
+    std::cout << "  --search-history <words>" << std::endl;
+    std::cout << "                       Finds logged songs on every station whose title matches the words."
+              << std::endl;
+    std::cout << "  --import-catalog <file>" << std::endl;
+    std::cout << "                       Builds a local station catalog from a Radio Browser dump (/json/stations)."
+              << std::endl;
+    std::cout << "                       Random mode and curation then work without the API." << std::endl;
+    std::cout << "  --refresh-catalog    Updates the local catalog with the API's station changes." << std::endl;
     std::cout << "  --help, -h           Displays this help message." << std::endl;
     std::cout << "\nEXAMPLE WORKFLOW:" << std::endl;
     std::cout << "  1. First Run:       ./build/stream-hopper (The setup wizard will run automatically)" << std::endl;
@@ -84,20 +94,63 @@ bool handle_cli_commands(int argc, const char* argv[]) {
     }
 
     if (arg == "--curate") {
+        std::string full_genre;
+        int limit = CliHandler::DEFAULT_CURATION_LIMIT;
+        for (int i = 2; i < argc; ++i) {
+            std::string word = argv[i];
+            if (word == "--limit" && i + 1 < argc) {
+                try {
+                    limit = std::stoi(argv[++i]);
+                } catch (const std::exception&) {
+                    std::cerr << "Error: --limit requires a number." << std::endl;
+                    return true;
+                }
+                continue;
+            }
+            if (!full_genre.empty()) {
+                full_genre += " ";
+            }
+            full_genre += word;
+        }
+        if (!full_genre.empty()) {
+            cli_handler.handle_curate_genre(full_genre, limit);
+        } else {
+            std::cerr << "Error: --curate flag requires a genre." << std::endl;
+            print_help();
+        }
+        return true; // Even if --curate had an error, it's a CLI command that should exit.
+    }
+
+    if (arg == "--search-history") {
         if (argc > 2) {
-            std::string full_genre;
+            std::string query;
             for (int i = 2; i < argc; ++i) {
-                full_genre += argv[i];
+                query += argv[i];
                 if (i < argc - 1) {
-                    full_genre += " ";
+                    query += " ";
                 }
             }
-            cli_handler.handle_curate_genre(full_genre);
+            cli_handler.handle_search_history(query);
         } else {
-            std::cerr << "Error: --curate flag requires a genre." << std::endl;
+            std::cerr << "Error: --search-history flag requires a query." << std::endl;
             print_help();
         }
-        return true; // Even if --curate had an error, it's a CLI command that should exit.
+        return true;
+    }
+
+    if (arg == "--import-catalog") {
+        if (argc > 2) {
+            cli_handler.handle_import_catalog(argv[2]);
+        } else {
+            std::cerr << "Error: --import-catalog flag requires a filename." << std::endl;
+            print_help();
+        }
+        return true;
+    }
+
+    if (arg == "--refresh-catalog") {
+        cli_handler.handle_refresh_catalog();
+        return true;
     }
     return false; // Not an immediate-exit command
 }
@@ -118,7 +171,8 @@ std::string determine_station_file(int argc, const char* argv[]) {
                 print_help();
                 return ""; // Indicate error
             }
-        } else if (arg1 != "--help" && arg1 != "-h" && arg1 != "--list-tags" && arg1 != "--curate") {
+        } else if (arg1 != "--help" && arg1 != "-h" && arg1 != "--list-tags" && arg1 != "--curate" &&
+                   arg1 != "--search-history" && arg1 != "--import-catalog" && arg1 != "--refresh-catalog") {
             // This case handles an unknown first argument that isn't '--from'
             // and wasn't caught by handle_cli_commands (which implies it was a standalone unknown command)
             std::cerr << "Error: Unknown command '" << arg1 << "'." << std::endl;